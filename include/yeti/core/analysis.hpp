@@ -0,0 +1,151 @@
+#ifndef E41FF6D3_2CC2_4B3D_B2CE_CDA4B0076A66
+#define E41FF6D3_2CC2_4B3D_B2CE_CDA4B0076A66
+
+#include <array>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+#include "yeti/core/generics.hpp"
+
+/**
+ * @brief Static properties of grammars.
+ *
+ * Parsers describe themselves via a `static constexpr grammar_info grammar`
+ * member and a constexpr `first()` method, combinators derive theirs from
+ * their children. Parsers that do neither are assumed to be opaque.
+ */
+
+namespace yeti {
+
+/**
+ * @brief A three-valued answer, `maybe` if it cannot be decided statically.
+ */
+enum class tri : unsigned char { no, yes, maybe };
+
+[[nodiscard]] constexpr auto operator&&(tri lhs, tri rhs) noexcept -> tri {
+  if (lhs == tri::no || rhs == tri::no) {
+    return tri::no;
+  }
+  return lhs == tri::yes && rhs == tri::yes ? tri::yes : tri::maybe;
+}
+
+[[nodiscard]] constexpr auto operator||(tri lhs, tri rhs) noexcept -> tri {
+  if (lhs == tri::yes || rhs == tri::yes) {
+    return tri::yes;
+  }
+  return lhs == tri::no && rhs == tri::no ? tri::no : tri::maybe;
+}
+
+/**
+ * @brief The properties of a grammar that depend only on its type.
+ */
+struct grammar_info {
+
+  static constexpr std::size_t unbounded = std::numeric_limits<std::size_t>::max();
+
+  tri nullable = tri::maybe;          ///< Can it succeed without consuming input.
+  std::size_t lookahead = unbounded; ///< The most tokens it reads from its start.
+
+  /**
+   * @brief Saturating sum of two lookaheads.
+   */
+  [[nodiscard]] static constexpr auto add(std::size_t a, std::size_t b) -> std::size_t {
+    return a > unbounded - b ? unbounded : a + b;
+  }
+
+  friend constexpr auto operator==(grammar_info, grammar_info) -> bool = default;
+};
+
+/**
+ * @brief The grammar of `P`, opaque parsers know nothing.
+ */
+template <typename P>
+inline constexpr grammar_info grammar_of = {};
+
+template <typename P>
+  requires std::same_as<P, strip<P>> &&
+           std::same_as<std::remove_cv_t<decltype(P::grammar)>, grammar_info>
+inline constexpr grammar_info grammar_of<P> = P::grammar;
+
+template <typename P>
+  requires different_from<P, strip<P>>
+inline constexpr grammar_info grammar_of<P> = grammar_of<strip<P>>;
+
+/**
+ * @brief True if `P` may succeed without consuming input.
+ */
+template <typename P>
+concept nullable = grammar_of<P>.nullable == tri::yes;
+
+/**
+ * @brief The set of byte sized tokens a consuming parse may start with.
+ *
+ * The empty parse is not included: a parser which is `nullable` (see
+ * `grammar_of<P>.nullable`) also succeeds on a token outside the set. If
+ * `all` is set the set is unknown/infinite and contains everything.
+ */
+struct first_set {
+
+  std::array<std::uint64_t, 4> bits{};
+  bool all = false;
+
+  [[nodiscard]] static constexpr auto any() noexcept -> first_set { return {{}, true}; }
+
+  [[nodiscard]] static constexpr auto of(unsigned char tok) noexcept -> first_set {
+    first_set out;
+    out.bits[tok / 64] |= std::uint64_t{1} << (tok % 64);
+    return out;
+  }
+
+  [[nodiscard]] constexpr auto contains(unsigned char tok) const noexcept -> bool {
+    return all || ((bits[tok / 64] >> (tok % 64)) & 1) != 0;
+  }
+
+  [[nodiscard]] constexpr auto size() const noexcept -> std::size_t {
+
+    if (all) {
+      return 256;
+    }
+
+    std::size_t n = 0;
+
+    for (std::uint64_t word : bits) {
+      n += static_cast<std::size_t>(std::popcount(word));
+    }
+
+    return n;
+  }
+
+  friend constexpr auto
+  operator|(first_set lhs, first_set const &rhs) noexcept -> first_set {
+    for (std::size_t i = 0; i < 4; ++i) {
+      lhs.bits[i] |= rhs.bits[i];
+    }
+    lhs.all = lhs.all || rhs.all;
+    return lhs;
+  }
+
+  friend constexpr auto
+  operator==(first_set const &, first_set const &) -> bool = default;
+};
+
+/**
+ * @brief The first set of `parser`, everything if it is opaque.
+ */
+template <typename P>
+[[nodiscard]] constexpr auto first_of(P const &parser) -> first_set {
+  if constexpr (requires {
+                  { parser.first() } -> std::same_as<first_set>;
+                }) {
+    return parser.first();
+  } else {
+    return first_set::any();
+  }
+}
+
+} // namespace yeti
+
+#endif /* E41FF6D3_2CC2_4B3D_B2CE_CDA4B0076A66 */
@@ -0,0 +1,139 @@
+#ifndef C12C1982_9E23_4EF6_BD70_F872DCA6A6B6
+#define C12C1982_9E23_4EF6_BD70_F872DCA6A6B6
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <vector>
+
+/**
+ * @brief Where the containers built by a parse are allocated.
+ */
+
+namespace yeti {
+
+namespace impl::arena_impl {
+
+// Null selects the global heap, without a virtual call per allocation.
+inline thread_local std::pmr::memory_resource *current = nullptr;
+
+} // namespace impl::arena_impl
+
+/**
+ * @brief The allocator of the containers built by `many` and `span`.
+ *
+ * It binds to the resource installed on the constructing thread (see
+ * `arena::use`), copies of a container rebind to the current one. During
+ * constant evaluation it binds to none, i.e. it is `std::allocator`.
+ */
+template <typename T>
+class allocator {
+ public:
+  using value_type = T;
+
+  constexpr allocator() noexcept {
+    if !consteval {
+      m_res = impl::arena_impl::current;
+    }
+  }
+
+  template <typename U>
+  constexpr allocator(allocator<U> const &other) noexcept
+      : m_res{other.resource()} {}
+
+  [[nodiscard]] constexpr auto allocate(std::size_t n) -> T * {
+    if (m_res == nullptr) {
+      return std::allocator<T>{}.allocate(n);
+    }
+    return static_cast<T *>(m_res->allocate(n * sizeof(T), alignof(T)));
+  }
+
+  constexpr void deallocate(T *ptr, std::size_t n) noexcept {
+    if (m_res == nullptr) {
+      std::allocator<T>{}.deallocate(ptr, n);
+    } else {
+      m_res->deallocate(ptr, n * sizeof(T), alignof(T));
+    }
+  }
+
+  [[nodiscard]] constexpr auto
+  select_on_container_copy_construction() const -> allocator {
+    return {};
+  }
+
+  /**
+   * @brief The resource allocated from, null for the global heap.
+   */
+  [[nodiscard]] constexpr auto resource() const noexcept -> std::pmr::memory_resource * {
+    return m_res;
+  }
+
+  template <typename U>
+  [[nodiscard]] friend constexpr auto
+  operator==(allocator const &lhs, allocator<U> const &rhs) noexcept -> bool {
+    return lhs.resource() == rhs.resource();
+  }
+
+ private:
+  std::pmr::memory_resource *m_res = nullptr;
+};
+
+/**
+ * @brief The container of repeated values.
+ */
+template <typename T>
+using vector = std::vector<T, allocator<T>>;
+
+/**
+ * @brief A monotonic arena for parse results.
+ *
+ * While a `scope` (see `use`) is alive every `yeti::vector` created on this
+ * thread, hence every result of `many` and `span`, is bump-allocated from
+ * the arena. Nothing is freed until `reset`, results must not be used after
+ * that. Other threads are unaffected.
+ */
+class arena {
+ public:
+  /**
+   * @brief RAII guard that installs a resource on the current thread.
+   */
+  class [[nodiscard]] scope {
+   public:
+    explicit scope(std::pmr::memory_resource *res) noexcept
+        : m_prev{impl::arena_impl::current} {
+      impl::arena_impl::current = res;
+    }
+
+    scope(scope const &) = delete;
+    scope(scope &&) = delete;
+    auto operator=(scope const &) -> scope & = delete;
+    auto operator=(scope &&) -> scope & = delete;
+
+    ~scope() { impl::arena_impl::current = m_prev; }
+
+   private:
+    std::pmr::memory_resource *m_prev;
+  };
+
+  /**
+   * @brief Create an arena whose first block is `initial` bytes.
+   */
+  explicit arena(std::size_t initial = 64 * 1024) : m_mono{initial} {}
+
+  /**
+   * @brief Route this thread's allocations into the arena.
+   */
+  auto use() noexcept -> scope { return scope{&m_mono}; }
+
+  /**
+   * @brief Free everything allocated from the arena in one go.
+   */
+  void reset() noexcept { m_mono.release(); }
+
+ private:
+  std::pmr::monotonic_buffer_resource m_mono;
+};
+
+} // namespace yeti
+
+#endif /* C12C1982_9E23_4EF6_BD70_F872DCA6A6B6 */
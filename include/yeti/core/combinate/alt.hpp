@@ -0,0 +1,163 @@
+#ifndef A1DD135D_00D1_47B7_BBF1_D65D4A98877E
+#define A1DD135D_00D1_47B7_BBF1_D65D4A98877E
+
+#include <algorithm>
+#include <expected>
+#include <format>
+#include <functional>
+#include <type_traits>
+#include <utility>
+
+#include "yeti/core/analysis.hpp"
+#include "yeti/core/blessed.hpp"
+#include "yeti/core/combinate/cut.hpp"
+#include "yeti/core/flat_variant.hpp"
+#include "yeti/core/generics.hpp"
+#include "yeti/core/parser.hpp"
+
+namespace yeti::impl::simplify_impl {
+
+// Defined in simplify.hpp, skipping/muting may enable further simplification.
+template <typename P, typename Q>
+[[nodiscard]] constexpr auto alternate(P &&lhs, Q &&rhs);
+
+} // namespace yeti::impl::simplify_impl
+
+namespace yeti::impl::alt_impl {
+
+/**
+ * @brief Both alternatives failed.
+ */
+template <error L, error R>
+struct err {
+
+  [[no_unique_address]] L lhs;
+  [[no_unique_address]] R rhs;
+
+  [[nodiscard]] constexpr auto what(this auto &&self) -> std::string {
+    return std::format("{} or {}", YETI_FWD(self).lhs.what(), YETI_FWD(self).rhs.what());
+  }
+
+  [[nodiscard]] constexpr auto hard() const -> bool { return cut_impl::is_hard(rhs); }
+};
+
+/**
+ * @brief If either side cannot fail then neither can the alternation.
+ */
+template <typename L, typename R>
+using both_t = std::conditional_t<
+    either<never, L, R>,
+    never,
+    std::conditional_t<std::same_as<L, unit> && std::same_as<R, unit>, unit, err<L, R>>>;
+
+/**
+ * @brief A hard error from `L` is returned as is, `R` is not tried.
+ */
+template <typename L, typename R>
+using error_t = std::conditional_t<cut_impl::may_be_hard<L>, //
+                                   flat_union<L, both_t<L, R>>,
+                                   both_t<L, R>>;
+
+template <parser P, parser Q>
+struct alt;
+
+template <typename P, typename Q>
+[[nodiscard]] constexpr auto alternate(P &&lhs, Q &&rhs)
+    YETI_HOF(alt<strip<P>, strip<Q>>{YETI_FWD(lhs), YETI_FWD(rhs)})
+
+template <parser P, parser Q>
+struct alt {
+
+  static_assert(std::same_as<P, strip<P>>);
+  static_assert(std::same_as<Q, strip<Q>>);
+
+  using type = std::conditional_t<typed<P>, type_of<P>, type_of<Q>>;
+
+  static constexpr grammar_info grammar = {
+      grammar_of<P>.nullable || grammar_of<Q>.nullable,
+      std::max(grammar_of<P>.lookahead, grammar_of<Q>.lookahead),
+  };
+
+  [[no_unique_address]] P lhs;
+  [[no_unique_address]] Q rhs;
+
+  [[nodiscard]] constexpr auto first() const -> first_set {
+    return first_of(lhs) | first_of(rhs);
+  }
+
+  [[nodiscard]] constexpr auto skip(this auto &&self) YETI_HOF(
+      simplify_impl::alternate(YETI_FWD(self).lhs.skip(), YETI_FWD(self).rhs.skip()))
+
+  [[nodiscard]] constexpr auto mute(this auto &&self) YETI_HOF(
+      simplify_impl::alternate(YETI_FWD(self).lhs.mute(), YETI_FWD(self).rhs.mute()))
+
+  /**
+   * @brief Try `lhs` then, from the same position, `rhs`.
+   *
+   * If both fail the unparsed input is that of `rhs`. If `lhs` fails past
+   * a cut then `rhs` is not tried.
+   */
+  template <typename S = type>
+    requires parser<P, strip<S>> && parser<Q, S>
+  [[nodiscard]] constexpr auto
+  operator()(this auto &&self, S &&stream) -> specialization_of<result> auto {
+
+    using L = parse_error_t<P, strip<S>>;
+    using R = parse_error_t<Q, S>;
+
+    using T = flat_union<parse_value_t<P, strip<S>>, parse_value_t<Q, S>>;
+    using E = error_t<L, R>;
+
+    using Res = resulting_t<S, T, E>;
+    using Exp = Res::expected_type;
+
+    auto [rest, first] = std::invoke(YETI_FWD(self).lhs, auto(stream));
+
+    if (first) {
+      return Res{
+          std::move(rest),
+          Exp{std::in_place, flat_cast<T>(std::move(first).value())},
+      };
+    }
+
+    if constexpr (cut_impl::may_be_hard<L>) {
+      if (cut_impl::is_hard(first.error())) {
+        return Res{
+            std::move(rest),
+            Exp{std::unexpect, flat_cast<E>(std::move(first).error())},
+        };
+      }
+    }
+
+    auto [tail, second] = std::invoke(YETI_FWD(self).rhs, YETI_FWD(stream));
+
+    if (second) {
+      return Res{
+          std::move(tail),
+          Exp{std::in_place, flat_cast<T>(std::move(second).value())},
+      };
+    }
+
+    using B = both_t<L, R>;
+
+    if constexpr (std::same_as<B, never>) {
+      std::unreachable();
+    } else if constexpr (std::same_as<B, unit>) {
+      return Res{std::move(tail), Exp{std::unexpect}};
+    } else {
+      B both{std::move(first).error(), std::move(second).error()};
+      return Res{std::move(tail), Exp{std::unexpect, flat_cast<E>(std::move(both))}};
+    }
+  }
+};
+
+} // namespace yeti::impl::alt_impl
+
+namespace yeti::impl::cut_impl {
+
+template <typename L, typename R>
+inline constexpr bool may_be_hard<alt_impl::err<L, R>> = may_be_hard<R>;
+
+} // namespace yeti::impl::cut_impl
+
+#endif /* A1DD135D_00D1_47B7_BBF1_D65D4A98877E */
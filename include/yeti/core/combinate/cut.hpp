@@ -0,0 +1,123 @@
+#ifndef D033AE5D_8A27_4B08_8E40_D57ABAA402A3
+#define D033AE5D_8A27_4B08_8E40_D57ABAA402A3
+
+#include <expected>
+#include <functional>
+#include <utility>
+
+#include "yeti/core/blessed.hpp"
+#include "yeti/core/flat_variant.hpp"
+#include "yeti/core/analysis.hpp"
+#include "yeti/core/generics.hpp"
+#include "yeti/core/parser.hpp"
+
+namespace yeti::impl::cut_impl {
+
+/**
+ * @brief An error raised past a cut, alternatives must not be tried.
+ */
+template <error E>
+struct hard {
+
+  [[no_unique_address]] E err;
+
+  [[nodiscard]] constexpr auto what(this auto &&self) YETI_HOF(YETI_FWD(self).err.what())
+};
+
+/**
+ * @brief True if an error of type `E` may be `hard`.
+ *
+ * Combinators whose errors wrap others specialise this and expose a
+ * `hard()` member that forwards to the error that failed last.
+ */
+template <typename E>
+inline constexpr bool may_be_hard = false;
+
+template <typename E>
+inline constexpr bool may_be_hard<hard<E>> = true;
+
+template <typename... Ts>
+inline constexpr bool may_be_hard<variant::flat_variant<Ts...>> =
+    (may_be_hard<Ts> || ...);
+
+/**
+ * @brief Test if `err` was raised past a cut.
+ */
+template <typename E>
+[[nodiscard]] constexpr auto is_hard(E const &err) -> bool {
+  if constexpr (!may_be_hard<E>) {
+    return false;
+  } else if constexpr (specialization_of<E, hard>) {
+    return true;
+  } else if constexpr (specialization_of<E, variant::flat_variant>) {
+    return err.visit([](auto const &member) static -> bool {
+      return is_hard(member);
+    });
+  } else {
+    return err.hard();
+  }
+}
+
+/**
+ * @brief Errors past a cut, `unit`/`never` cannot carry the mark.
+ */
+template <typename E>
+using error_t = std::conditional_t<either<E, unit, never>, E, hard<E>>;
+
+struct no_hook {};
+
+template <parser P, typename F>
+struct cut;
+
+template <typename P, typename F = no_hook>
+[[nodiscard]] constexpr auto make(P &&parser, F &&hook = {})
+    YETI_HOF(cut<strip<P>, strip<F>>{YETI_FWD(parser), YETI_FWD(hook)})
+
+template <parser P, typename F>
+struct cut {
+
+  static_assert(std::same_as<P, strip<P>>);
+  static_assert(std::same_as<F, strip<F>>);
+
+  using type = type_of<P>;
+
+  static constexpr grammar_info grammar = grammar_of<P>;
+
+  [[no_unique_address]] P fn;
+  [[no_unique_address]] F hook;
+
+  [[nodiscard]] constexpr auto first() const -> first_set { return first_of(fn); }
+
+  [[nodiscard]] constexpr auto skip(this auto &&self)
+      YETI_HOF(make(YETI_FWD(self).fn.skip(), YETI_FWD(self).hook))
+
+  [[nodiscard]] constexpr auto mute(this auto &&self)
+      YETI_HOF(make(YETI_FWD(self).fn.mute(), YETI_FWD(self).hook))
+
+  template <typename S = type>
+    requires parser<P, S>
+  [[nodiscard]] constexpr auto
+  operator()(this auto &&self, S &&stream) -> specialization_of<result> auto {
+
+    using E = parse_error_t<P, S>;
+
+    using Res = resulting_t<S, parse_value_t<P, S>, error_t<E>>;
+    using Exp = Res::expected_type;
+
+    if constexpr (!std::same_as<F, no_hook>) {
+      std::invoke(YETI_FWD(self).hook, std::as_const(stream));
+    }
+
+    auto [rest, result] = std::invoke(YETI_FWD(self).fn, YETI_FWD(stream));
+
+    if (result) {
+      return Res{std::move(rest), Exp{std::in_place, std::move(result).value()}};
+    }
+
+    return Res{std::move(rest), Exp{std::unexpect, std::move(result).error()}};
+  }
+};
+
+} // namespace yeti::impl::cut_impl
+
+#endif /* D033AE5D_8A27_4B08_8E40_D57ABAA402A3 */
@@ -5,6 +5,8 @@
 #include <functional>
 
 #include "yeti/core/blessed.hpp"
+#include "yeti/core/combinate/cut.hpp"
+#include "yeti/core/analysis.hpp"
 #include "yeti/core/generics.hpp"
 #include "yeti/core/parser.hpp"
 #include "yeti/core/rebind.hpp"
@@ -28,6 +30,8 @@ struct err {
   }
 
 #undef WHAT
+
+  [[nodiscard]] constexpr auto hard() const -> bool { return cut_impl::is_hard(err); }
 };
 
 template <parser P, error D>
@@ -44,9 +48,13 @@ struct described {
 
   using type = type_of<P>;
 
+  static constexpr grammar_info grammar = grammar_of<P>;
+
   [[no_unique_address]] P fn;
   [[no_unique_address]] D desc;
 
+  [[nodiscard]] constexpr auto first() const -> first_set { return first_of(fn); }
+
   [[nodiscard]] constexpr auto skip(this auto &&self)
       YETI_HOF(describe(YETI_FWD(self).fn.skip(), YETI_FWD(self).desc))
 
@@ -77,4 +85,11 @@ struct described {
 
 } // namespace yeti::impl::desc
 
+namespace yeti::impl::cut_impl {
+
+template <typename D, typename E>
+inline constexpr bool may_be_hard<desc::err<D, E>> = may_be_hard<E>;
+
+} // namespace yeti::impl::cut_impl
+
 #endif /* C4611F7D_9EF7_4FB5_BA9A_6B5B8893FE89 */
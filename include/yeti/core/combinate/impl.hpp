@@ -4,11 +4,17 @@
 #include <concepts>
 #include <functional>
 
+#include "yeti/core/analysis.hpp"
 #include "yeti/core/generics.hpp"
 #include "yeti/core/parser.hpp"
 #include "yeti/core/typed.hpp"
 
+#include "yeti/core/combinate/alt.hpp"
+#include "yeti/core/combinate/cut.hpp"
 #include "yeti/core/combinate/desc.hpp"
+#include "yeti/core/combinate/many.hpp"
+#include "yeti/core/combinate/simplify.hpp"
+#include "yeti/core/combinate/then.hpp"
 #include "yeti/core/combinate/typed.hpp"
 
 namespace yeti {
@@ -30,6 +36,17 @@ template <specialization_of<combinator> P>
   return YETI_FWD(parser);
 }
 
+// Unwrap a combinator such that combinators nest their parsers directly.
+template <typename P>
+[[nodiscard]] constexpr auto decombinate(P &&parser) noexcept -> P && {
+  return YETI_FWD(parser);
+}
+
+template <specialization_of<combinator> P>
+[[nodiscard]] constexpr auto decombinate(P &&parser) noexcept -> auto && {
+  return YETI_FWD(parser).fn;
+}
+
 template <typename P>
   requires parser<P>
 struct combinator final {
@@ -38,8 +55,15 @@ struct combinator final {
 
   using type = type_of<P>;
 
+  static constexpr grammar_info grammar = grammar_of<P>;
+
   [[no_unique_address]] P fn;
 
+  /**
+   * @brief The tokens a successful parse may start with, see `first_set`.
+   */
+  [[nodiscard]] constexpr auto first() const -> first_set { return first_of(fn); }
+
   /**
    * @brief Apply the parser to the input `stream`.
    */
@@ -87,6 +111,70 @@ struct combinator final {
   // ===  === //
   // ===  === //
 
+  /**
+   * @brief Parse with this then `other`.
+   *
+   * The value is a `std::tuple` of both values, except that `unit` values are
+   * dropped, hence `p.then(q.skip())` keeps only the value of `p`.
+   *
+   * Sequencing with `pure` is elided, as is anything after a parser that
+   * cannot succeed e.g. `fail`.
+   */
+  template <typename Q>
+    requires parser<strip<Q>>
+  [[nodiscard]] constexpr auto then(this auto &&self, Q &&other) YETI_HOF(recombinate(
+      simplify_impl::sequence(YETI_FWD(self).fn, decombinate(YETI_FWD(other)))))
+
+  /**
+   * @brief Parse with this or, if that fails, backtrack and parse with `other`.
+   *
+   * The value/error types are merged as by `flat_union`. If this is `fail`
+   * the result is just `other`, if this cannot fail `other` is dropped.
+   */
+  template <typename Q>
+    requires parser<strip<Q>>
+  [[nodiscard]] constexpr auto alt(this auto &&self, Q &&other) YETI_HOF(recombinate(
+      simplify_impl::alternate(YETI_FWD(self).fn, decombinate(YETI_FWD(other)))))
+
+  /**
+   * @brief Apply this parser zero or more times.
+   *
+   * This fails only if the parser fails past a `cut`.
+   */
+  [[nodiscard]] constexpr auto many(this auto &&self)
+      YETI_HOF(recombinate(simplify_impl::repeat(YETI_FWD(self).fn)))
+
+  /**
+   * @brief Commit to this branch, failures of this parser are hard.
+   *
+   * An enclosing `alt`/`many` does not backtrack out of a hard failure, it
+   * propagates with the exact position it occurred at, e.g. in
+   * `alt(lit('(').then(expr.cut()), atom)` a missing ')' is reported as
+   * such rather than as "expected atom".
+   *
+   * The commitment is not scoped to the enclosing rule: a hard failure
+   * vetoes every enclosing `alt`/`many` up to the root. To end it at a rule
+   * boundary mute the rule, muting erases the mark along with the error.
+   */
+  [[nodiscard]] constexpr auto cut(this auto &&self)
+      YETI_HOF(recombinate(cut_impl::make(YETI_FWD(self).fn)))
+
+  /**
+   * @brief As `cut()` but invoke `hook` with the stream at the cut.
+   *
+   * The hook may release state before the cut (`buffered::commit`,
+   * `packrat::release`), only do so if no enclosing parser can backtrack
+   * past it, e.g. at a record boundary.
+   */
+  template <typename F>
+    requires storable<F>
+  [[nodiscard]] constexpr auto cut(this auto &&self, F &&hook)
+      YETI_HOF(recombinate(cut_impl::make(YETI_FWD(self).fn, YETI_FWD(hook))))
+
+  // ===  === //
+  // ===  === //
+  // ===  === //
+
   template <typename Type>
     requires pure_void<type> && std::same_as<Type, strip<Type>>
   [[nodiscard]] constexpr auto typed(this auto &&self)
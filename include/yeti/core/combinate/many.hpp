@@ -0,0 +1,128 @@
+#ifndef EECC9348_3286_4C6E_A691_8A0C62FB63E1
+#define EECC9348_3286_4C6E_A691_8A0C62FB63E1
+
+#include <concepts>
+#include <expected>
+#include <functional>
+#include <ranges>
+#include <type_traits>
+#include <utility>
+
+#include "yeti/core/analysis.hpp"
+#include "yeti/core/arena.hpp"
+#include "yeti/core/blessed.hpp"
+#include "yeti/core/combinate/cut.hpp"
+#include "yeti/core/generics.hpp"
+#include "yeti/core/lift.hpp"
+#include "yeti/core/parser.hpp"
+
+namespace yeti::impl::simplify_impl {
+
+// Defined in simplify.hpp, skipping may enable fusion.
+template <typename P>
+[[nodiscard]] constexpr auto repeat(P &&parser);
+
+} // namespace yeti::impl::simplify_impl
+
+namespace yeti::impl::many_impl {
+
+/**
+ * @brief Repeating a parser that yields nothing yields nothing.
+ */
+template <typename T>
+using value_t = std::conditional_t<either<T, unit, never>, unit, vector<T>>;
+
+// True if `rest` is strictly after `prev`, assumed for input ranges and
+// for parsers that always consume.
+template <tri Nullable, typename S>
+[[nodiscard]] constexpr auto progressed(S const &prev, S const &rest) -> bool {
+  if constexpr (Nullable == tri::no) {
+    return true;
+  } else if constexpr (std::ranges::forward_range<S const>) {
+    return std::ranges::begin(prev) != std::ranges::begin(rest);
+  } else {
+    return true;
+  }
+}
+
+template <parser P>
+struct many;
+
+template <typename P>
+[[nodiscard]] constexpr auto repeat(P &&parser)
+    YETI_HOF(many<strip<P>>{YETI_FWD(parser)})
+
+template <parser P>
+struct many {
+
+  static_assert(std::same_as<P, strip<P>>);
+
+  static_assert(!nullable<P>, "Repeating a parser that can succeed without consuming "
+                              "input would loop forever");
+
+  using type = type_of<P>;
+
+  static constexpr grammar_info grammar = {
+      tri::yes,
+      grammar_of<P>.lookahead == 0 ? 0 : grammar_info::unbounded,
+  };
+
+  [[no_unique_address]] P fn;
+
+  [[nodiscard]] constexpr auto first() const -> first_set { return first_of(fn); }
+
+  [[nodiscard]] constexpr auto skip(this auto &&self)
+      YETI_HOF(simplify_impl::repeat(YETI_FWD(self).fn.skip()))
+
+  // Only fails past a cut, which muting erases.
+  [[nodiscard]] constexpr auto mute(this auto &&self)
+      YETI_HOF(parser_lift::lifted<many, false, true>{YETI_FWD(self)})
+
+  /**
+   * @brief Apply the parser until it fails or stops consuming input.
+   *
+   * This fails only if the parser fails past a cut.
+   */
+  template <typename S = type>
+    requires parser<P, strip<S>>
+  [[nodiscard]] constexpr auto
+  operator()(this auto &&self, S &&stream) -> specialization_of<result> auto {
+
+    using V = value_t<parse_value_t<P, strip<S>>>;
+    using E = parse_error_t<P, strip<S>>;
+
+    using Res = resulting_t<S, V, std::conditional_t<cut_impl::may_be_hard<E>, E, never>>;
+    using Exp = Res::expected_type;
+
+    strip<S> cur = YETI_FWD(stream);
+
+    V acc{};
+
+    for (;;) {
+
+      auto [rest, result] = std::invoke(self.fn, auto(cur));
+
+      if constexpr (cut_impl::may_be_hard<E>) {
+        if (!result && cut_impl::is_hard(result.error())) {
+          return Res{std::move(rest), Exp{std::unexpect, std::move(result).error()}};
+        }
+      }
+
+      if (!result || !progressed<grammar_of<P>.nullable>(cur, rest)) {
+        break;
+      }
+
+      if constexpr (!std::same_as<V, unit>) {
+        acc.push_back(std::move(result).value());
+      }
+
+      cur = std::move(rest);
+    }
+
+    return Res{std::move(cur), Exp{std::in_place, std::move(acc)}};
+  }
+};
+
+} // namespace yeti::impl::many_impl
+
+#endif /* EECC9348_3286_4C6E_A691_8A0C62FB63E1 */
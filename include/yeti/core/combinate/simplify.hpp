@@ -0,0 +1,198 @@
+#ifndef C716D6CB_7856_4E68_A0A2_FD36DABEBCC8
+#define C716D6CB_7856_4E68_A0A2_FD36DABEBCC8
+
+#include <type_traits>
+#include <utility>
+
+#include "yeti/core/generics.hpp"
+#include "yeti/core/lift.hpp"
+
+#include "yeti/core/combinate/alt.hpp"
+#include "yeti/core/combinate/cut.hpp"
+#include "yeti/core/combinate/desc.hpp"
+#include "yeti/core/combinate/many.hpp"
+#include "yeti/core/combinate/then.hpp"
+#include "yeti/core/combinate/typed.hpp"
+
+/**
+ * @brief Algebraic simplification of combinator trees.
+ *
+ * The identities used are those of `unit`/`never`: `pure` is the unit of
+ * sequencing, `fail` is the unit of alternation and absorbs everything
+ * sequenced after it. Parsers opt in by specialising the traits below, the
+ * structural combinators derive theirs from their children.
+ *
+ * Parsers may also fuse, e.g. a run of literals into one compare, by
+ * specialising `fuse_then`/`fuse_alt`/`fuse_many` with a static `fuse`.
+ */
+
+namespace yeti::impl::simplify_impl {
+
+/**
+ * @brief True if `P` succeeds with `unit`, consuming nothing, on any input.
+ */
+template <typename P>
+inline constexpr bool is_pure = false;
+
+/**
+ * @brief True if `P` fails softly, consuming nothing, on any input.
+ */
+template <typename P>
+inline constexpr bool is_fail = false;
+
+/**
+ * @brief True if the value type of `P` is `never` for every stream.
+ */
+template <typename P>
+inline constexpr bool never_succeeds = is_fail<P>;
+
+/**
+ * @brief True if the error type of `P` is `never` for every stream.
+ */
+template <typename P>
+inline constexpr bool never_fails = false;
+
+// ===  === //
+// ===  === //
+// ===  === //
+
+template <typename F, bool Skip, bool Mute>
+inline constexpr bool is_pure<parser_lift::lifted<F, Skip, Mute>> = is_pure<F>;
+
+template <typename F, bool Skip, bool Mute>
+inline constexpr bool is_fail<parser_lift::lifted<F, Skip, Mute>> = is_fail<F>;
+
+template <typename F, bool Skip, bool Mute>
+inline constexpr bool never_succeeds<parser_lift::lifted<F, Skip, Mute>> =
+    never_succeeds<F>;
+
+template <typename F, bool Skip, bool Mute>
+inline constexpr bool never_fails<parser_lift::lifted<F, Skip, Mute>> = never_fails<F>;
+
+template <typename P, typename D>
+inline constexpr bool is_fail<desc::described<P, D>> = is_fail<P>;
+
+template <typename P, typename D>
+inline constexpr bool never_succeeds<desc::described<P, D>> = never_succeeds<P>;
+
+template <typename P, typename D>
+inline constexpr bool never_fails<desc::described<P, D>> = never_fails<P>;
+
+template <typename P, typename T>
+inline constexpr bool is_fail<typed::typed<P, T>> = is_fail<P>;
+
+template <typename P, typename T>
+inline constexpr bool never_succeeds<typed::typed<P, T>> = never_succeeds<P>;
+
+template <typename P, typename T>
+inline constexpr bool never_fails<typed::typed<P, T>> = never_fails<P>;
+
+// A cut changes how, not whether, its parser fails.
+template <typename P, typename F>
+inline constexpr bool never_succeeds<cut_impl::cut<P, F>> = never_succeeds<P>;
+
+template <typename P, typename F>
+inline constexpr bool never_fails<cut_impl::cut<P, F>> = never_fails<P>;
+
+template <typename P, typename Q>
+inline constexpr bool never_succeeds<then_impl::then<P, Q>> =
+    never_succeeds<P> || never_succeeds<Q>;
+
+template <typename P, typename Q>
+inline constexpr bool never_fails<then_impl::then<P, Q>> =
+    never_fails<P> && never_fails<Q>;
+
+template <typename P, typename Q>
+inline constexpr bool is_fail<alt_impl::alt<P, Q>> = is_fail<P> && is_fail<Q>;
+
+template <typename P, typename Q>
+inline constexpr bool never_succeeds<alt_impl::alt<P, Q>> =
+    never_succeeds<P> && never_succeeds<Q>;
+
+template <typename P, typename Q>
+inline constexpr bool never_fails<alt_impl::alt<P, Q>> =
+    never_fails<P> || never_fails<Q>;
+
+/**
+ * @brief Specialise with a static `fuse(lhs, rhs)` replacing `lhs` then `rhs`.
+ */
+template <typename P, typename Q>
+struct fuse_then {};
+
+/**
+ * @brief Specialise with a static `fuse(lhs, rhs)` replacing `lhs` or `rhs`.
+ */
+template <typename P, typename Q>
+struct fuse_alt {};
+
+/**
+ * @brief Specialise with a static `fuse(p)` replacing `many(p)`.
+ */
+template <typename P>
+struct fuse_many {};
+
+template <typename Fuse, typename... P>
+concept fuses = requires(P &&...parser) { Fuse::fuse(YETI_FWD(parser)...); };
+
+// ===  === //
+// ===  === //
+// ===  === //
+
+// Nothing sequenced after `P` is ever run, past a cut or not. Unlike in an
+// `alt` a parser that may fail hard is fine here.
+template <typename P>
+inline constexpr bool absorbs = never_succeeds<P>;
+
+template <typename P, typename F>
+inline constexpr bool absorbs<cut_impl::cut<P, F>> = absorbs<P>;
+
+/**
+ * @brief Build `lhs` then `rhs` modulo `pure`/`never` identities.
+ */
+template <typename P, typename Q>
+[[nodiscard]] constexpr auto sequence(P &&lhs, Q &&rhs) {
+  if constexpr (is_pure<strip<P>>) {
+    return strip<Q>{YETI_FWD(rhs)};
+  } else if constexpr (is_pure<strip<Q>> || absorbs<strip<P>>) {
+    return strip<P>{YETI_FWD(lhs)};
+  } else if constexpr (fuses<fuse_then<strip<P>, strip<Q>>, P, Q>) {
+    return fuse_then<strip<P>, strip<Q>>::fuse(YETI_FWD(lhs), YETI_FWD(rhs));
+  } else {
+    return then_impl::sequence(YETI_FWD(lhs), YETI_FWD(rhs));
+  }
+}
+
+/**
+ * @brief Build `lhs` or `rhs` modulo `fail`/infallible identities.
+ *
+ * This narrows the value/error types, the dropped branch could never have
+ * contributed to them at runtime.
+ */
+template <typename P, typename Q>
+[[nodiscard]] constexpr auto alternate(P &&lhs, Q &&rhs) {
+  if constexpr (never_fails<strip<P>>) {
+    return strip<P>{YETI_FWD(lhs)};
+  } else if constexpr (is_fail<strip<P>>) {
+    return strip<Q>{YETI_FWD(rhs)};
+  } else if constexpr (fuses<fuse_alt<strip<P>, strip<Q>>, P, Q>) {
+    return fuse_alt<strip<P>, strip<Q>>::fuse(YETI_FWD(lhs), YETI_FWD(rhs));
+  } else {
+    return alt_impl::alternate(YETI_FWD(lhs), YETI_FWD(rhs));
+  }
+}
+
+/**
+ * @brief Build `many(parser)`, fused if `parser` supports it.
+ */
+template <typename P>
+[[nodiscard]] constexpr auto repeat(P &&parser) {
+  if constexpr (fuses<fuse_many<strip<P>>, P>) {
+    return fuse_many<strip<P>>::fuse(YETI_FWD(parser));
+  } else {
+    return many_impl::repeat(YETI_FWD(parser));
+  }
+}
+
+} // namespace yeti::impl::simplify_impl
+
+#endif /* C716D6CB_7856_4E68_A0A2_FD36DABEBCC8 */
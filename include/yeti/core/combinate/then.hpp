@@ -0,0 +1,122 @@
+#ifndef CB0FC6AB_1BC5_40E0_A337_70BA6029579D
+#define CB0FC6AB_1BC5_40E0_A337_70BA6029579D
+
+#include <expected>
+#include <functional>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "yeti/core/analysis.hpp"
+#include "yeti/core/blessed.hpp"
+#include "yeti/core/flat_variant.hpp"
+#include "yeti/core/generics.hpp"
+#include "yeti/core/parser.hpp"
+
+namespace yeti::impl::simplify_impl {
+
+// Defined in simplify.hpp, skipping/muting may enable further simplification.
+template <typename P, typename Q>
+[[nodiscard]] constexpr auto sequence(P &&lhs, Q &&rhs);
+
+} // namespace yeti::impl::simplify_impl
+
+namespace yeti::impl::then_impl {
+
+/**
+ * @brief The value of `L` then `R`, `unit` values are dropped.
+ */
+template <typename L, typename R>
+using value_t = std::conditional_t<
+    either<never, L, R>,
+    never,
+    std::conditional_t<std::same_as<L, unit>,
+                       R,
+                       std::conditional_t<std::same_as<R, unit>, L, std::tuple<L, R>>>>;
+
+template <parser P, parser Q>
+struct then;
+
+template <typename P, typename Q>
+[[nodiscard]] constexpr auto sequence(P &&lhs, Q &&rhs)
+    YETI_HOF(then<strip<P>, strip<Q>>{YETI_FWD(lhs), YETI_FWD(rhs)})
+
+template <parser P, parser Q>
+struct then {
+
+  static_assert(std::same_as<P, strip<P>>);
+  static_assert(std::same_as<Q, strip<Q>>);
+
+  using type = std::conditional_t<typed<P>, type_of<P>, type_of<Q>>;
+
+  static constexpr grammar_info grammar = {
+      grammar_of<P>.nullable && grammar_of<Q>.nullable,
+      grammar_info::add(grammar_of<P>.lookahead, grammar_of<Q>.lookahead),
+  };
+
+  [[no_unique_address]] P lhs;
+  [[no_unique_address]] Q rhs;
+
+  [[nodiscard]] constexpr auto first() const -> first_set {
+    if constexpr (grammar_of<P>.nullable == tri::no) {
+      return first_of(lhs);
+    } else {
+      return first_of(lhs) | first_of(rhs);
+    }
+  }
+
+  [[nodiscard]] constexpr auto skip(this auto &&self) YETI_HOF(
+      simplify_impl::sequence(YETI_FWD(self).lhs.skip(), YETI_FWD(self).rhs.skip()))
+
+  [[nodiscard]] constexpr auto mute(this auto &&self) YETI_HOF(
+      simplify_impl::sequence(YETI_FWD(self).lhs.mute(), YETI_FWD(self).rhs.mute()))
+
+  template <typename S = type>
+    requires parser<P, S> && parser<Q, strip<S>>
+  [[nodiscard]] constexpr auto
+  operator()(this auto &&self, S &&stream) -> specialization_of<result> auto {
+
+    using L = parse_value_t<P, S>;
+    using R = parse_value_t<Q, strip<S>>;
+    using T = value_t<L, R>;
+    using E = flat_union<parse_error_t<P, S>, parse_error_t<Q, strip<S>>>;
+
+    using Res = resulting_t<S, T, E>;
+    using Exp = Res::expected_type;
+
+    auto [rest, first] = std::invoke(YETI_FWD(self).lhs, YETI_FWD(stream));
+
+    if (!first) {
+      return Res{
+          std::move(rest),
+          Exp{std::unexpect, flat_cast<E>(std::move(first).error())},
+      };
+    }
+
+    auto [tail, second] = std::invoke(YETI_FWD(self).rhs, std::move(rest));
+
+    if (!second) {
+      return Res{
+          std::move(tail),
+          Exp{std::unexpect, flat_cast<E>(std::move(second).error())},
+      };
+    }
+
+    if constexpr (std::same_as<T, never>) {
+      std::unreachable();
+    } else if constexpr (std::same_as<L, unit>) {
+      return Res{std::move(tail), Exp{std::in_place, std::move(second).value()}};
+    } else if constexpr (std::same_as<R, unit>) {
+      return Res{std::move(tail), Exp{std::in_place, std::move(first).value()}};
+    } else {
+      return Res{
+          std::move(tail),
+          Exp{std::in_place, std::move(first).value(), std::move(second).value()},
+      };
+    }
+  }
+};
+
+} // namespace yeti::impl::then_impl
+
+#endif /* CB0FC6AB_1BC5_40E0_A337_70BA6029579D */
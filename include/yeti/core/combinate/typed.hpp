@@ -3,6 +3,7 @@
 
 #include <functional>
 
+#include "yeti/core/analysis.hpp"
 #include "yeti/core/generics.hpp"
 #include "yeti/core/parser.hpp"
 
@@ -26,6 +27,10 @@ struct typed {
 
   using type = T;
 
+  static constexpr grammar_info grammar = grammar_of<P>;
+
+  [[nodiscard]] constexpr auto first() const -> first_set { return first_of(fn); }
+
   template <typename S = type>
     requires parser<P, S> && std::same_as<T, strip<S>>
   [[nodiscard]] constexpr auto operator()(this auto &&self, S &&stream)
@@ -46,6 +46,44 @@ template <typename P>
   return YETI_FWD(parser);
 }
 
+// ===  === //
+// ===  === //
+// ===  === //
+
+/**
+ * @brief Sequence parsers left to right, see `combinator::then`.
+ */
+inline constexpr auto then = [](this auto const &self, auto &&first, auto &&...rest) {
+  if constexpr (sizeof...(rest) == 0) {
+    return combinate(YETI_FWD(first));
+  } else {
+    return combinate(YETI_FWD(first)).then(self(YETI_FWD(rest)...));
+  }
+};
+
+/**
+ * @brief Try parsers left to right until one succeeds, see `combinator::alt`.
+ */
+inline constexpr auto alt = [](this auto const &self, auto &&first, auto &&...rest) {
+  if constexpr (sizeof...(rest) == 0) {
+    return combinate(YETI_FWD(first));
+  } else {
+    return combinate(YETI_FWD(first)).alt(self(YETI_FWD(rest)...));
+  }
+};
+
+/**
+ * @brief Make the failures of a parser hard, see `combinator::cut`.
+ */
+inline constexpr auto cut = [](auto &&parser, auto &&...hook) static
+    YETI_HOF(combinate(YETI_FWD(parser)).cut(YETI_FWD(hook)...));
+
+/**
+ * @brief Apply a parser zero or more times, see `combinator::many`.
+ */
+inline constexpr auto many = [](auto &&parser) static
+    YETI_HOF(combinate(YETI_FWD(parser)).many());
+
 } // namespace yeti
 
 #endif /* EFAF34CE_6AFE_403C_AA49_FBDC9BC80BB7 */
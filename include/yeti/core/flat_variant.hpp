@@ -3,6 +3,7 @@
 
 #include <functional>
 #include <type_traits>
+#include <utility>
 #include <variant>
 
 #include "yeti/core/blessed.hpp"
@@ -105,6 +106,12 @@ struct merge_flat<list<>, flat_variant<Ls...>, flat_variant<Rs...>, Ts...>
 template <typename... Ts>
 using merge_flat_t = merge_flat<list<>, Ts...>::type;
 
+template <typename T>
+struct unwrap : std::type_identity<T> {};
+
+template <typename T>
+struct unwrap<flat_variant<T>> : std::type_identity<T> {};
+
 } // namespace impl::variant
 
 /**
@@ -122,6 +129,36 @@ using merge_flat_t = merge_flat<list<>, Ts...>::type;
 template <typename... T>
 using flat_variant = impl::variant::merge_flat_t<T...>;
 
+/**
+ * @brief A `flat_variant` that collapses to `T` if only `T` remains.
+ *
+ * Hence `flat_union<unit, unit> == unit` and `flat_union<never, T> == T`,
+ * this is what the combinators use to merge value/error types.
+ */
+template <typename... T>
+using flat_union = impl::variant::unwrap<flat_variant<T...>>::type;
+
+/**
+ * @brief Convert `val` into the flat variant `V`.
+ *
+ * `val` may be one of the members of `V` or itself a flat variant whose
+ * members are all members of `V`. Converting a `never` is unreachable.
+ */
+template <typename V, typename T>
+[[nodiscard]] constexpr auto flat_cast(T &&val) -> V {
+  if constexpr (std::same_as<strip<T>, V>) {
+    return YETI_FWD(val);
+  } else if constexpr (std::same_as<strip<T>, never>) {
+    std::unreachable();
+  } else if constexpr (specialization_of<T, impl::variant::flat_variant>) {
+    return YETI_FWD(val).visit([](auto &&member) -> V {
+      return flat_cast<V>(YETI_FWD(member));
+    });
+  } else {
+    return V{YETI_FWD(val)};
+  }
+}
+
 // static_assert(std::same_as<T, impl::variant::flat_variant<int, float>>);
 
 } // namespace yeti
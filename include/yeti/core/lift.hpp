@@ -6,6 +6,7 @@
 #include <type_traits>
 #include <utility>
 
+#include "yeti/core/analysis.hpp"
 #include "yeti/core/generics.hpp"
 #include "yeti/core/parser_fn.hpp"
 #include "yeti/core/parser_obj.hpp"
@@ -55,8 +56,12 @@ struct lifted_base {
 
   using type = type_of<F>;
 
+  static constexpr grammar_info grammar = grammar_of<F>;
+
   [[no_unique_address]] F fn;
 
+  [[nodiscard]] constexpr auto first() const -> first_set { return first_of(fn); }
+
   [[nodiscard]] constexpr auto skip(this auto &&self)
       YETI_HOF(lifted<F, true, Mute>{YETI_FWD(self).fn})
 
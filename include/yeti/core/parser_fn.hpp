@@ -159,10 +159,13 @@ concept parser_fn_help =                                    //
 
 /**
  * @brief The lowest level of the parser concept.
+ *
+ * Parsers need only be movable, such that they can own large tables. A
+ * move-only parser must be moved into combinators (or wrapped in `ref`).
  */
 template <typename P, typename S = void, typename T = void, typename E = void>
 concept parser_fn =                            //
-    std::copy_constructible<P>                 //
+    std::move_constructible<P>                 //
     && type_matches<P, S>                      //
     && parser_fn_help<P, type_of<P>, S, T, E>; //
 
@@ -1,6 +1,8 @@
 #ifndef BE31620B_E9D8_42F5_B265_579BFEA7DE92
 #define BE31620B_E9D8_42F5_B265_579BFEA7DE92
 
+#include <concepts>
+
 #include "yeti/core/parser_fn.hpp"
 
 namespace yeti {
@@ -28,14 +30,17 @@ concept similar_skippable =
 /**
  * @brief Check that `P.skip() -> _` is valid for all invocations.
  *
- * All the invocations must return the same type.
+ * All the invocations must return the same type. A move-only `P` cannot
+ * copy itself into the result, it is only required to skip as an rvalue.
  */
 template <typename P>
-concept parser_obj_skippable = skippable<P>                         //
-                               && similar_skippable<P, P &>         //
-                               && similar_skippable<P, P const &>   //
-                               && similar_skippable<P, P &&>        //
-                               && similar_skippable<P, P const &&>; //
+concept parser_obj_skippable =
+    skippable<P>                                      //
+    && similar_skippable<P, P &&>                     //
+    && (!std::copy_constructible<P> ||                //
+        (similar_skippable<P, P &>                    //
+         && similar_skippable<P, P const &>           //
+         && similar_skippable<P, P const &&>));       //
 
 // ===  === //
 // ===  === //
@@ -57,14 +62,17 @@ concept similar_muteable =
 /**
  * @brief Check that `P.mute() -> _` is valid for all invocations.
  *
- * All the invocations must return the same type.
+ * All the invocations must return the same type, as for `skip` a move-only
+ * `P` is only required to mute as an rvalue.
  */
 template <typename P>
-concept parser_obj_muteable = muteable<P>                         //
-                              && similar_muteable<P, P &>         //
-                              && similar_muteable<P, P const &>   //
-                              && similar_muteable<P, P &&>        //
-                              && similar_muteable<P, P const &&>; //
+concept parser_obj_muteable =
+    muteable<P>                                      //
+    && similar_muteable<P, P &&>                     //
+    && (!std::copy_constructible<P> ||               //
+        (similar_muteable<P, P &>                    //
+         && similar_muteable<P, P const &>           //
+         && similar_muteable<P, P const &&>));       //
 
 // ===  === //
 // ===  === //
@@ -3,9 +3,13 @@
 
 #include <concepts>
 #include <expected>
+#include <memory>
 #include <string>
 #include <string_view>
+#include <type_traits>
+#include <utility>
 
+#include "yeti/core/blessed.hpp"
 #include "yeti/core/generics.hpp"
 
 namespace yeti {
@@ -23,6 +27,165 @@ concept error_view = error<E> && requires (E e) {
   { e.what() } -> std::same_as<std::string_view>;
 };
 
+namespace impl::result_impl {
+
+/**
+ * @brief A type with one value that is free to copy.
+ */
+template <typename T>
+concept hollow = std::is_empty_v<T> && std::is_trivially_copyable_v<T> &&
+                 std::default_initializable<T>;
+
+// Arguments that select another constructor.
+template <typename T, typename Self>
+concept tag = std::same_as<strip<T>, Self> ||                 //
+              specialization_of<T, std::unexpected> ||        //
+              specialization_of<T, std::expected> ||          //
+              std::same_as<strip<T>, std::in_place_t> ||      //
+              std::same_as<strip<T>, std::unexpect_t>;        //
+
+/**
+ * @brief An `std::expected<T, E>` of hollow types, only the discriminator.
+ */
+template <hollow T, hollow E>
+class flag {
+ public:
+  using value_type = T;
+  using error_type = E;
+
+  constexpr flag() = default;
+
+  template <typename U = T>
+    requires (!tag<U, flag>) && std::constructible_from<T, U>
+  constexpr flag(U &&) noexcept {}
+
+  template <typename... Args>
+    requires std::constructible_from<T, Args...>
+  constexpr explicit flag(std::in_place_t, Args &&...) noexcept {}
+
+  template <typename... Args>
+    requires std::constructible_from<E, Args...>
+  constexpr explicit flag(std::unexpect_t, Args &&...) noexcept : m_ok{false} {}
+
+  template <typename G>
+    requires std::constructible_from<E, G>
+  constexpr flag(std::unexpected<G> const &) noexcept : m_ok{false} {}
+
+  template <typename U, typename G>
+    requires std::constructible_from<T, U> && std::constructible_from<E, G>
+  constexpr flag(std::expected<U, G> const &other) noexcept : m_ok{other.has_value()} {}
+
+  [[nodiscard]] constexpr auto has_value() const noexcept -> bool { return m_ok; }
+
+  [[nodiscard]] constexpr explicit operator bool() const noexcept { return m_ok; }
+
+  [[nodiscard]] constexpr auto value() const -> T {
+    if (!m_ok) {
+      throw std::bad_expected_access<E>(E{});
+    }
+    return T{};
+  }
+
+  [[nodiscard]] constexpr auto operator*() const noexcept -> T { return T{}; }
+
+  [[nodiscard]] constexpr auto error() const noexcept -> E { return E{}; }
+
+  friend constexpr auto operator==(flag const &, flag const &) -> bool = default;
+
+ private:
+  bool m_ok = true;
+};
+
+/**
+ * @brief An `std::expected<T, never>`, only the value.
+ */
+template <std::movable T>
+class infallible {
+ public:
+  using value_type = T;
+  using error_type = never;
+
+  constexpr infallible() = default;
+
+  template <typename U = T>
+    requires (!tag<U, infallible>) && std::constructible_from<T, U>
+  constexpr infallible(U &&val) : m_val(YETI_FWD(val)) {}
+
+  template <typename... Args>
+    requires std::constructible_from<T, Args...>
+  constexpr explicit infallible(std::in_place_t, Args &&...args)
+      : m_val(YETI_FWD(args)...) {}
+
+  // Only reachable with a `never` in hand, i.e. not at all.
+  template <typename... Args>
+    requires std::constructible_from<never, Args...>
+  constexpr explicit infallible(std::unexpect_t, Args &&...) : m_val{bottom()} {}
+
+  template <typename G>
+    requires std::constructible_from<never, G const &>
+  constexpr infallible(std::unexpected<G> const &) : m_val{bottom()} {}
+
+  template <typename U>
+    requires std::constructible_from<T, U const &>
+  constexpr infallible(std::expected<U, never> const &other) : m_val(*other) {}
+
+  template <typename U>
+    requires std::constructible_from<T, U>
+  constexpr infallible(std::expected<U, never> &&other) : m_val(*std::move(other)) {}
+
+  [[nodiscard]] static constexpr auto has_value() noexcept -> bool { return true; }
+
+  [[nodiscard]] constexpr explicit operator bool() const noexcept { return true; }
+
+  [[nodiscard]] constexpr auto value(this auto &&self) noexcept -> auto && {
+    return YETI_FWD(self).m_val;
+  }
+
+  [[nodiscard]] constexpr auto operator*(this auto &&self) noexcept -> auto && {
+    return YETI_FWD(self).m_val;
+  }
+
+  [[nodiscard]] constexpr auto operator->(this auto &self) noexcept -> auto * {
+    return std::addressof(self.m_val);
+  }
+
+  [[noreturn]] constexpr auto error(this auto &&) noexcept -> never const & {
+    std::unreachable();
+  }
+
+  friend constexpr auto
+  operator==(infallible const &, infallible const &) -> bool = default;
+
+  template <typename U>
+    requires (!std::same_as<U, infallible>) && std::equality_comparable_with<T, U>
+  friend constexpr auto operator==(infallible const &lhs, U const &rhs) -> bool {
+    return lhs.m_val == rhs;
+  }
+
+ private:
+  [[noreturn]] static auto bottom() -> T { std::unreachable(); }
+
+  [[no_unique_address]] T m_val = T();
+};
+
+template <typename T, typename E>
+struct compact {
+  using type = std::expected<T, E>;
+};
+
+template <hollow T, hollow E>
+struct compact<T, E> {
+  using type = flag<T, E>;
+};
+
+template <typename T>
+  requires (!std::same_as<T, never>)
+struct compact<T, never> {
+  using type = infallible<T>;
+};
+
+} // namespace impl::result_impl
+
 /**
  * @brief The result of invoking a yeti parser.
  *
@@ -30,6 +193,13 @@ concept error_view = error<E> && requires (E e) {
  *
  * TIP: Try destructuring the result type to get the value and the rest.
  *
+ * The `expected` member is an `std::expected<T, E>` unless a smaller layout
+ * says the same: a recognizer (`T` and `E` empty, e.g. after `drop`) keeps
+ * only the discriminator and a parser that cannot fail (`E` is `never`) only
+ * the value. Hence `result<std::string_view, unit, never>` is two pointers
+ * and is returned in registers. Both have the parts of the `std::expected`
+ * interface that parsers use.
+ *
  * @tparam T The type of the result of the parse.
  * @tparam E The type of the error of the parse.
  * @tparam S The type of stream that the parser consumes.
@@ -41,7 +211,7 @@ struct result {
   using error_type = E;
 
   using unparsed_type = S;
-  using expected_type = std::expected<T, E>;
+  using expected_type = impl::result_impl::compact<T, E>::type;
 
   [[no_unique_address]] unparsed_type unparsed; ///< Unconsumed input.
   [[no_unique_address]] expected_type expected; ///< The result of the parse.
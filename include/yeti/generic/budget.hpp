@@ -0,0 +1,241 @@
+#ifndef D667F10F_E082_4EF3_8772_C24CA8826076
+#define D667F10F_E082_4EF3_8772_C24CA8826076
+
+#include <cstddef>
+#include <expected>
+#include <functional>
+#include <iterator>
+#include <ranges>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+#include "yeti/core.hpp"
+#include "yeti/core/analysis.hpp"
+#include "yeti/core/combinate/cut.hpp"
+#include "yeti/core/flat_variant.hpp"
+#include "yeti/core/generics.hpp"
+
+/**
+ * @brief Bounding the work a parse may do.
+ */
+
+namespace yeti {
+
+/**
+ * @brief The parse ran out of steps, see `budget`.
+ */
+struct budget_exceeded {
+  static constexpr auto what() noexcept -> std::string_view {
+    return "The parse exceeded its step budget";
+  }
+};
+
+/**
+ * @brief The token tests left to a `metered` stream and its copies.
+ */
+struct meter {
+
+  std::size_t left = 0;
+  bool truncated = false; ///< A stream ended early because `left` reached zero.
+
+  [[nodiscard]] constexpr auto exhausted() const noexcept -> bool { return truncated; }
+};
+
+/**
+ * @brief A view of `S` that charges a `meter` for every token read.
+ *
+ * Once the meter is exhausted the stream appears to end, every parser then
+ * fails or stops promptly. Backtracking re-reads tokens hence it is charged
+ * again. The meter must outlive the stream.
+ */
+template <std::ranges::forward_range S>
+class metered {
+ public:
+  using base_iterator = std::ranges::iterator_t<S>;
+  using base_sentinel = std::ranges::sentinel_t<S>;
+
+  class sentinel {
+   public:
+    sentinel() = default;
+
+    constexpr explicit sentinel(base_sentinel end) : m_end{std::move(end)} {}
+
+    [[nodiscard]] constexpr auto base() const -> base_sentinel const & { return m_end; }
+
+   private:
+    base_sentinel m_end;
+  };
+
+  class iterator {
+   public:
+    using value_type = std::iter_value_t<base_iterator>;
+    using difference_type = std::iter_difference_t<base_iterator>;
+
+    iterator() = default;
+
+    constexpr iterator(base_iterator it, meter *left)
+        : m_it{std::move(it)},
+          m_meter{left} {}
+
+    constexpr auto operator*() const -> std::iter_reference_t<base_iterator> {
+      if (m_meter->left > 0) {
+        --m_meter->left;
+      }
+      return *m_it;
+    }
+
+    constexpr auto operator++() -> iterator & {
+      ++m_it;
+      return *this;
+    }
+
+    constexpr auto operator++(int) -> iterator {
+      auto tmp = *this;
+      ++m_it;
+      return tmp;
+    }
+
+    [[nodiscard]] constexpr auto base() const -> base_iterator const & { return m_it; }
+
+    friend constexpr auto operator==(iterator const &lhs, iterator const &rhs) -> bool {
+      return lhs.m_it == rhs.m_it;
+    }
+
+    friend constexpr auto operator==(iterator const &it, sentinel const &end) -> bool {
+
+      if (it.m_it == end.base()) {
+        return true;
+      }
+
+      if (it.m_meter->left == 0) {
+        it.m_meter->truncated = true;
+        return true;
+      }
+
+      return false;
+    }
+
+   private:
+    base_iterator m_it{};
+    meter *m_meter = nullptr;
+  };
+
+  metered() = default;
+
+  constexpr metered(S const &stream, meter &left)
+      : m_beg{std::ranges::begin(stream), &left},
+        m_end{std::ranges::end(stream)} {}
+
+  constexpr metered(iterator beg, sentinel end)
+      : m_beg{std::move(beg)},
+        m_end{std::move(end)} {}
+
+  [[nodiscard]] constexpr auto begin() const -> iterator { return m_beg; }
+
+  [[nodiscard]] constexpr auto end() const -> sentinel { return m_end; }
+
+  [[nodiscard]] constexpr auto empty() const -> bool { return m_beg == m_end; }
+
+  /**
+   * @brief The same position in the underlying stream.
+   */
+  [[nodiscard]] constexpr auto base() const -> S { return S{m_beg.base(), m_end.base()}; }
+
+ private:
+  iterator m_beg;
+  sentinel m_end;
+};
+
+namespace impl::budget_impl {
+
+template <typename S>
+struct unmetered : std::type_identity<S> {};
+
+template <typename S>
+struct unmetered<metered<S>> : std::type_identity<S> {};
+
+template <parser P>
+struct budgeted;
+
+template <typename P>
+[[nodiscard]] constexpr auto make(P &&parser, std::size_t steps)
+    YETI_HOF(budgeted<strip<P>>{YETI_FWD(parser), steps})
+
+template <parser P>
+struct budgeted {
+
+  static_assert(std::same_as<P, strip<P>>);
+
+  using type = unmetered<type_of<P>>::type;
+
+  static constexpr grammar_info grammar = grammar_of<P>;
+
+  [[no_unique_address]] P fn;
+  std::size_t steps;
+
+  [[nodiscard]] constexpr auto first() const -> first_set { return first_of(fn); }
+
+  [[nodiscard]] constexpr auto skip(this auto &&self)
+      YETI_HOF(make(YETI_FWD(self).fn.skip(), self.steps))
+
+  [[nodiscard]] constexpr auto mute(this auto &&self)
+      YETI_HOF(make(YETI_FWD(self).fn.mute(), self.steps))
+
+  template <typename S = type>
+    requires parser<P, metered<strip<S>>>
+  [[nodiscard]] constexpr auto
+  operator()(this auto &&self, S &&stream) -> specialization_of<result> auto {
+
+    using M = metered<strip<S>>;
+
+    using E = parse_error_t<P, M>;
+    using Er = std::conditional_t<std::same_as<E, unit>,
+                                  unit,
+                                  flat_union<E, cut_impl::hard<budget_exceeded>>>;
+
+    using Res = resulting_t<S, parse_value_t<P, M>, Er>;
+    using Exp = Res::expected_type;
+
+    meter left{self.steps};
+
+    auto [rest, res] = std::invoke(YETI_FWD(self).fn, M{stream, left});
+
+    if (left.exhausted()) {
+      if constexpr (std::same_as<Er, unit>) {
+        return Res{rest.base(), Exp{std::unexpect}};
+      } else {
+        using Hard = cut_impl::hard<budget_exceeded>;
+        return Res{rest.base(), Exp{std::unexpect, flat_cast<Er>(Hard{})}};
+      }
+    }
+
+    if (res) {
+      return Res{rest.base(), Exp{std::in_place, std::move(res).value()}};
+    }
+
+    return Res{rest.base(), Exp{std::unexpect, flat_cast<Er>(std::move(res).error())}};
+  }
+};
+
+} // namespace impl::budget_impl
+
+/**
+ * @brief Fail `fn` with `budget_exceeded` if it reads over `steps` tokens.
+ *
+ * The parser is invoked with a `metered` view of the stream (typed parsers
+ * must be declared over `metered<S>`, e.g. `recursive<metered<S>, T>`) which
+ * charges every token test, including those repeated after backtracking.
+ * The error is hard (see `cut`) such that enclosing alternatives do not
+ * spend more. Parsers that are not budgeted never see a `metered` stream,
+ * they pay nothing.
+ */
+inline constexpr auto budget = []<typename P>(P &&fn, std::size_t steps) static
+  requires parser<strip<P>>
+{
+  return combinate(impl::budget_impl::make(YETI_FWD(fn), steps));
+};
+
+} // namespace yeti
+
+#endif /* D667F10F_E082_4EF3_8772_C24CA8826076 */
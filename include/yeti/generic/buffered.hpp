@@ -0,0 +1,231 @@
+#ifndef E85C1A3B_6F97_4D2E_B04A_93C7E2D5F618
+#define E85C1A3B_6F97_4D2E_B04A_93C7E2D5F618
+
+#include <algorithm>
+#include <bit>
+#include <cerrno>
+#include <concepts>
+#include <cstddef>
+#include <istream>
+#include <iterator>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <system_error>
+#include <utility>
+
+#include <unistd.h>
+
+/**
+ * @brief Streams that refill from a source on demand.
+ */
+
+namespace yeti {
+
+/**
+ * @brief Something bytes can be pulled from, `read` returns 0 at the end.
+ */
+template <typename S>
+concept byte_source = requires (S &src, std::span<char> buf) {
+  { src.read(buf) } -> std::convertible_to<std::size_t>;
+};
+
+/**
+ * @brief Pull bytes from a `std::istream`.
+ */
+class istream_source {
+ public:
+  explicit istream_source(std::istream &in) noexcept : m_in{&in} {}
+
+  auto read(std::span<char> buf) -> std::size_t {
+    auto size = static_cast<std::streamsize>(buf.size());
+    return static_cast<std::size_t>(m_in->rdbuf()->sgetn(buf.data(), size));
+  }
+
+ private:
+  std::istream *m_in;
+};
+
+/**
+ * @brief Pull bytes from a (POSIX) file descriptor, e.g. a pipe or a file.
+ */
+class fd_source {
+ public:
+  explicit fd_source(int fd) noexcept : m_fd{fd} {}
+
+  auto read(std::span<char> buf) -> std::size_t {
+    for (;;) {
+      if (auto n = ::read(m_fd, buf.data(), buf.size()); n >= 0) {
+        return static_cast<std::size_t>(n);
+      }
+      if (errno != EINTR) {
+        throw std::system_error(errno, std::system_category(), "read");
+      }
+    }
+  }
+
+ private:
+  int m_fd;
+};
+
+/**
+ * @brief A ring buffer over a `byte_source` exposing a refillable stream.
+ *
+ * Bytes are addressed by their absolute offset in the source. The buffer
+ * retains every byte from the last `commit` onwards, hence the distance a
+ * parser may run ahead of (or backtrack to) the commit point is bounded by
+ * the capacity. Exceeding it throws `std::length_error`, touching released
+ * bytes throws `std::out_of_range`.
+ *
+ * Memory is constant: `commit` whatever will never be backtracked to (e.g.
+ * after every record) and arbitrarily long inputs can be parsed.
+ *
+ * Views and iterators point at the buffer which is therefore immovable.
+ */
+template <byte_source Src>
+class buffered {
+ public:
+  class iterator {
+   public:
+    using value_type = char;
+    using difference_type = std::ptrdiff_t;
+
+    iterator() = default;
+
+    iterator(buffered *buf, std::size_t pos) noexcept : m_buf{buf}, m_pos{pos} {}
+
+    auto operator*() const -> char { return m_buf->at(m_pos); }
+
+    auto operator++() noexcept -> iterator & {
+      ++m_pos;
+      return *this;
+    }
+
+    auto operator++(int) noexcept -> iterator {
+      auto tmp = *this;
+      ++m_pos;
+      return tmp;
+    }
+
+    /**
+     * @brief The absolute offset of this iterator in the source.
+     */
+    [[nodiscard]] auto offset() const noexcept -> std::size_t { return m_pos; }
+
+    friend auto operator==(iterator const &lhs, iterator const &rhs) noexcept -> bool {
+      return lhs.m_pos == rhs.m_pos;
+    }
+
+    friend auto operator==(iterator const &it, std::default_sentinel_t) -> bool {
+      return it.at_end();
+    }
+
+   private:
+    friend class buffered;
+
+    [[nodiscard]] auto at_end() const -> bool { return m_buf->exhausted(m_pos); }
+
+    buffered *m_buf = nullptr;
+    std::size_t m_pos = 0;
+  };
+
+  /**
+   * @brief The stream type, a forward range from some offset to the end.
+   */
+  class view {
+   public:
+    view() = default;
+
+    view(iterator beg, std::default_sentinel_t) noexcept : m_beg{beg} {}
+
+    [[nodiscard]] auto begin() const noexcept -> iterator { return m_beg; }
+
+    [[nodiscard]] static auto end() noexcept -> std::default_sentinel_t { return {}; }
+
+    [[nodiscard]] auto empty() const -> bool { return m_beg == std::default_sentinel; }
+
+   private:
+    iterator m_beg;
+  };
+
+  /**
+   * @brief Buffer `src` retaining at least `capacity` bytes.
+   */
+  explicit buffered(Src src, std::size_t capacity = 64 * 1024)
+      : m_src{std::move(src)},
+        m_mask{std::bit_ceil(std::max<std::size_t>(capacity, 1)) - 1},
+        m_data{std::make_unique<char[]>(m_mask + 1)} {}
+
+  buffered(buffered const &) = delete;
+  buffered(buffered &&) = delete;
+  auto operator=(buffered const &) -> buffered & = delete;
+  auto operator=(buffered &&) -> buffered & = delete;
+  ~buffered() = default;
+
+  /**
+   * @brief The stream from the commit point onwards.
+   */
+  [[nodiscard]] auto stream() noexcept -> view { return {{this, m_base}, {}}; }
+
+  /**
+   * @brief Release every byte before `rest`, they can no longer be read.
+   */
+  void commit(view const &rest) noexcept { commit(rest.begin()); }
+
+  void commit(iterator const &it) noexcept { m_base = std::max(m_base, it.m_pos); }
+
+  [[nodiscard]] auto capacity() const noexcept -> std::size_t { return m_mask + 1; }
+
+ private:
+  // Ensure the byte at `pos` is buffered, false if the source ended first.
+  auto fill_to(std::size_t pos) -> bool {
+    while (pos >= m_filled) {
+
+      if (m_eof) {
+        return false;
+      }
+
+      std::size_t used = m_filled - m_base;
+
+      if (used == capacity()) {
+        throw std::length_error("yeti::buffered ran past its window, commit more often");
+      }
+
+      std::size_t beg = m_filled & m_mask;
+      std::size_t len = std::min(capacity() - used, capacity() - beg);
+
+      std::size_t got = m_src.read({m_data.get() + beg, len});
+
+      m_eof = got == 0;
+      m_filled += got;
+    }
+
+    return true;
+  }
+
+  auto exhausted(std::size_t pos) -> bool { return pos >= m_filled && !fill_to(pos); }
+
+  auto at(std::size_t pos) -> char {
+
+    if (pos < m_base) {
+      throw std::out_of_range("yeti::buffered backtracked before its commit point");
+    }
+
+    if (!fill_to(pos)) {
+      throw std::out_of_range("yeti::buffered dereferenced the end of the stream");
+    }
+
+    return m_data[pos & m_mask];
+  }
+
+  Src m_src;
+  std::size_t m_mask;
+  std::unique_ptr<char[]> m_data;
+  std::size_t m_base = 0;   ///< Absolute offset of the oldest retained byte.
+  std::size_t m_filled = 0; ///< Absolute offset one past the newest byte.
+  bool m_eof = false;
+};
+
+} // namespace yeti
+
+#endif /* E85C1A3B_6F97_4D2E_B04A_93C7E2D5F618 */
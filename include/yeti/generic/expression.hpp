@@ -0,0 +1,263 @@
+#ifndef F20676F2_9B26_4DAC_B90E_5DB3AE225D1D
+#define F20676F2_9B26_4DAC_B90E_5DB3AE225D1D
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <optional>
+#include <tuple>
+#include <utility>
+
+#include "yeti/core.hpp"
+#include "yeti/core/analysis.hpp"
+#include "yeti/core/generics.hpp"
+
+/**
+ * @brief Operator precedence grammars in a single pass.
+ */
+
+namespace yeti {
+
+/**
+ * @brief The associativity of an infix operator.
+ */
+enum class assoc { left, right };
+
+namespace impl::expr_impl {
+
+enum class fixity { prefix, infix, postfix };
+
+// The default callback, valid only when the atoms have no value.
+struct ignore {};
+
+template <fixity Fix, int Prec, assoc Dir, typename P, typename F>
+struct op {
+
+  static constexpr fixity fix = Fix;
+  static constexpr int prec = Prec;
+
+  // The minimum precedence of the operand(s) to the right.
+  static constexpr int next = Prec + int{Fix == fixity::infix && Dir == assoc::left};
+
+  [[no_unique_address]] P parser;
+  [[no_unique_address]] F fn;
+};
+
+template <typename>
+inline constexpr bool is_op = false;
+
+template <fixity Fix, int Prec, assoc Dir, typename P, typename F>
+inline constexpr bool is_op<op<Fix, Prec, Dir, P, F>> = true;
+
+template <fixity Fix, int Prec, assoc Dir = assoc::left>
+struct make_op {
+  template <typename P, typename F = ignore>
+    requires parser<strip<P>> && storable<F>
+  static constexpr auto operator()(P &&parser, F &&fn = {})
+      -> op<Fix, Prec, Dir, strip<P>, strip<F>> {
+    return {YETI_FWD(parser), YETI_FWD(fn)};
+  }
+};
+
+template <typename A, typename... Ops>
+struct expr;
+
+template <typename A, typename... Ops>
+[[nodiscard]] constexpr auto make(A &&atom, std::tuple<Ops...> ops)
+    YETI_HOF(expr<strip<A>, Ops...>{YETI_FWD(atom), std::move(ops)})
+
+template <typename A, typename... Ops>
+struct expr {
+
+  static_assert(std::same_as<A, strip<A>>);
+
+  using type = type_of<A>;
+
+  // Prefix and postfix operators are optional, so only the atom decides.
+  static constexpr grammar_info grammar = {
+      grammar_of<A>.nullable,
+      grammar_info::unbounded,
+  };
+
+  [[no_unique_address]] A atom;
+  [[no_unique_address]] std::tuple<Ops...> ops;
+
+  /**
+   * @brief An expression starts with an atom or a prefix operator.
+   */
+  [[nodiscard]] constexpr auto first() const -> first_set {
+    return std::apply(
+        [&](auto const &...op) {
+          first_set out = first_of(atom);
+          ((out = op.fix == fixity::prefix ? out | first_of(op.parser) : out), ...);
+          return out;
+        },
+        ops);
+  }
+
+  [[nodiscard]] constexpr auto skip(this auto &&self)
+      YETI_HOF(make(YETI_FWD(self).atom.skip(), YETI_FWD(self).ops))
+
+  [[nodiscard]] constexpr auto mute(this auto &&self)
+      YETI_HOF(make(YETI_FWD(self).atom.mute(), YETI_FWD(self).ops))
+
+  template <typename S = type>
+    requires parser<A, strip<S>>
+  [[nodiscard]] constexpr auto
+  operator()(this auto const &self, S &&stream) -> specialization_of<result> auto {
+    return self.climb(std::numeric_limits<int>::min(), strip<S>{YETI_FWD(stream)});
+  }
+
+  template <typename S>
+  using climb_t = result<S, parse_value_t<A, S>, parse_error_t<A, S>>;
+
+  // Callbacks are only invoked if there are values to fold.
+  template <typename T>
+  static constexpr bool folds = !either<T, unit, never>;
+
+  // Invoke `fn(op, rest)` for the first operator of fixity `Fix` binding at
+  // least as tightly as `min` that matches at `stream`.
+  template <fixity Fix, typename S, typename Fn>
+  constexpr auto match(int min, S const &stream, Fn &&fn) const -> bool {
+    return std::apply(
+        [&](auto const &...op) -> bool {
+          return ([&](auto const &o) -> bool {
+            if constexpr (strip<decltype(o)>::fix != Fix) {
+              return false;
+            } else {
+              if (strip<decltype(o)>::prec < min) {
+                return false;
+              }
+
+              auto [rest, res] = std::invoke(o.parser, auto(stream));
+
+              if (!res) {
+                return false;
+              }
+
+              fn(o, std::move(rest));
+              return true;
+            }
+          }(op) || ...);
+        },
+        ops);
+  }
+
+  // Precedence climbing, parse an expression of operators binding at least
+  // as tightly as `min`.
+  template <typename S>
+  constexpr auto climb(int min, S stream) const -> climb_t<S> {
+
+    using R = climb_t<S>;
+    using T = R::value_type;
+
+    std::optional<R> out;
+
+    // A prefix operator binds its operand, not a lhs, hence any may start
+    // an operand, e.g. `2*-3`. Its operand binds at least as tightly as both
+    // the prefix and the enclosing operand, e.g. `2^-1*3` is `(2^-1)*3`.
+    int any = std::numeric_limits<int>::min();
+
+    bool prefixed = match<fixity::prefix>(any, stream, [&](auto const &o, S rest) {
+      R operand = climb(std::max(min, o.next), std::move(rest));
+
+      if constexpr (folds<T>) {
+        if (operand) {
+          *operand.expected = std::invoke(o.fn, std::move(*operand.expected));
+        }
+      }
+
+      out.emplace(std::move(operand));
+    });
+
+    if (!prefixed) {
+      out.emplace(std::invoke(atom, std::move(stream)));
+    }
+
+    auto postfix = [&](auto const &o, S rest) {
+      out->unparsed = std::move(rest);
+
+      if constexpr (folds<T>) {
+        *out->expected = std::invoke(o.fn, std::move(*out->expected));
+      }
+    };
+
+    auto infix = [&](auto const &o, S rest) {
+      R rhs = climb(o.next, std::move(rest));
+
+      if (!rhs) {
+        out.emplace(std::move(rhs));
+        return;
+      }
+
+      out->unparsed = std::move(rhs.unparsed);
+
+      if constexpr (folds<T>) {
+        auto lhs = std::move(*out->expected);
+        *out->expected = std::invoke(o.fn, std::move(lhs), std::move(*rhs.expected));
+      }
+    };
+
+    while (*out && (match<fixity::postfix>(min, out->unparsed, postfix) ||
+                    match<fixity::infix>(min, out->unparsed, infix))) {
+    }
+
+    return std::move(*out);
+  }
+};
+
+} // namespace impl::expr_impl
+
+/**
+ * @brief Declare an infix operator, higher precedences bind tighter.
+ *
+ * `fn(lhs, rhs)` folds the values of the operands, it may be omitted if the
+ * atoms have no value. The value of the operator parser is ignored.
+ */
+template <int Prec, assoc Dir = assoc::left>
+inline constexpr auto infix =
+    impl::expr_impl::make_op<impl::expr_impl::fixity::infix, Prec, Dir>{};
+
+/**
+ * @brief Declare a prefix operator, `fn(operand)` folds its value.
+ */
+template <int Prec>
+inline constexpr auto prefix =
+    impl::expr_impl::make_op<impl::expr_impl::fixity::prefix, Prec>{};
+
+/**
+ * @brief Declare a postfix operator, `fn(operand)` folds its value.
+ */
+template <int Prec>
+inline constexpr auto postfix =
+    impl::expr_impl::make_op<impl::expr_impl::fixity::postfix, Prec>{};
+
+/**
+ * @brief Parse `atom`s joined by operators in one precedence-climbing pass.
+ *
+ * The operator table is fixed at compile time, operators are tried in
+ * declaration order and the values are folded as the input is parsed, no
+ * tree is built. For example, integer arithmetic:
+ *
+ * @code
+ * auto arith = expression(number,
+ *                         infix<1>(lit('+'), std::plus{}),
+ *                         infix<2>(lit('*'), std::multiplies{}),
+ *                         infix<3, assoc::right>(lit('^'), power),
+ *                         prefix<2>(lit('-'), std::negate{}));
+ * @endcode
+ *
+ * The value and error types are those of `atom`, operators that fail to
+ * parse simply end the expression. Failing to parse an operand after an
+ * operator fails the whole expression at that position.
+ */
+inline constexpr auto expression =
+    []<typename A, typename... Ops>(A &&atom, Ops &&...ops) static
+  requires parser<strip<A>> && (impl::expr_impl::is_op<strip<Ops>> && ...)
+{
+  return combinate(impl::expr_impl::make(YETI_FWD(atom), std::tuple{YETI_FWD(ops)...}));
+};
+
+} // namespace yeti
+
+#endif /* F20676F2_9B26_4DAC_B90E_5DB3AE225D1D */
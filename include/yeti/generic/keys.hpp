@@ -0,0 +1,64 @@
+#ifndef D6AA4B4D_F389_48B2_9E03_68003D468F62
+#define D6AA4B4D_F389_48B2_9E03_68003D468F62
+
+#include <concepts>
+#include <ranges>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "yeti/core/generics.hpp"
+
+/**
+ * @brief Collecting the runtime keys of a dictionary.
+ */
+
+namespace yeti::impl {
+
+/**
+ * @brief Views of a range of strings, which stay valid while this lives.
+ *
+ * Only lvalues and non-owning strings are viewed in place. Any other key
+ * (e.g. a `std::pmr::string` yielded by a view) may die with its iterator,
+ * so it is copied.
+ */
+class key_views {
+ public:
+  template <std::ranges::input_range R>
+    requires std::convertible_to<std::ranges::range_reference_t<R>, std::string_view>
+  explicit key_views(R &&keys) {
+
+    using Ref = std::ranges::range_reference_t<R>;
+
+    constexpr bool owned = !std::is_lvalue_reference_v<Ref> &&
+                           !either<strip<Ref>, std::string_view, char const *, char *>;
+
+    for (auto &&k : keys) {
+      if constexpr (!owned) {
+        m_views.emplace_back(k);
+      } else if constexpr (std::same_as<strip<Ref>, std::string>) {
+        m_store.emplace_back(YETI_FWD(k));
+      } else {
+        m_store.emplace_back(std::string_view(k));
+      }
+    }
+
+    if constexpr (owned) {
+      m_views.assign(m_store.begin(), m_store.end()); // After any reallocation.
+    }
+  }
+
+  [[nodiscard]] auto get() const noexcept -> std::vector<std::string_view> const & {
+    return m_views;
+  }
+
+ private:
+  std::vector<std::string> m_store;
+  std::vector<std::string_view> m_views;
+};
+
+} // namespace yeti::impl
+
+#endif /* D6AA4B4D_F389_48B2_9E03_68003D468F62 */
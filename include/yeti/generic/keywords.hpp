@@ -0,0 +1,316 @@
+#ifndef EC53C625_6402_4C31_88E0_48BDD74FE67F
+#define EC53C625_6402_4C31_88E0_48BDD74FE67F
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <iterator>
+#include <memory>
+#include <ranges>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "yeti/core.hpp"
+#include "yeti/core/analysis.hpp"
+#include "yeti/core/combinate/fixed.hpp"
+#include "yeti/core/generics.hpp"
+
+/**
+ * @brief Choosing among fixed keywords with a compile time perfect hash.
+ */
+
+namespace yeti {
+
+namespace impl::keyword_impl {
+
+// ===  === //
+// ===  === //
+// ===  === //
+
+/**
+ * @brief FNV-1a of the first `prefix` bytes, the last byte and the length.
+ */
+template <typename T>
+[[nodiscard]] constexpr auto
+digest(T const *key, std::size_t len, std::size_t prefix) noexcept -> std::uint64_t {
+
+  constexpr std::uint64_t prime = 0x100000001b3;
+
+  std::uint64_t h = 0xcbf29ce484222325 ^ len;
+
+  for (std::size_t i = 0, n = std::min(len, prefix); i < n; ++i) {
+    h = (h ^ static_cast<unsigned char>(key[i])) * prime;
+  }
+
+  return (h ^ static_cast<unsigned char>(key[len - 1])) * prime;
+}
+
+// Re-seedable finalizer (murmur3) over a digest.
+[[nodiscard]] constexpr auto
+mix(std::uint64_t h, std::uint64_t seed) noexcept -> std::uint64_t {
+  h ^= seed * 0x9e3779b97f4a7c15;
+  h ^= h >> 33;
+  h *= 0xff51afd7ed558ccd;
+  h ^= h >> 33;
+  h *= 0xc4ceb9fe1a85ec53;
+  h ^= h >> 33;
+  return h;
+}
+
+/**
+ * @brief The perfect hash over `N` keywords of `Chars` bytes in total.
+ *
+ * Hash-and-displace: keywords are grouped into buckets by one hash, each
+ * bucket gets a displacement that maps its keywords to free slots.
+ */
+template <std::size_t N, std::size_t Chars>
+struct table {
+
+  static constexpr std::size_t slots = std::bit_ceil(2 * N);
+  static constexpr std::size_t buckets = std::max(std::bit_ceil(N) / 4, std::size_t{1});
+
+  std::array<char, Chars> text{};
+  std::array<std::size_t, N> offset{};
+  std::array<std::size_t, N> length{};
+
+  std::array<std::size_t, N> lengths{}; // Distinct lengths, descending.
+  std::size_t distinct = 0;
+  std::size_t prefix = 1;
+
+  std::array<std::uint32_t, buckets> disp{};
+  std::array<std::uint16_t, slots> slot{}; // Keyword index + 1, 0 if free.
+
+  first_set first;
+
+  [[nodiscard]] constexpr auto key(std::size_t i) const noexcept -> std::string_view {
+    return {text.data() + offset[i], length[i]};
+  }
+
+  // The candidate keyword for `len` bytes at `key`.
+  template <typename T>
+  [[nodiscard]] constexpr auto find(T const *key, std::size_t len) const noexcept
+      -> std::size_t {
+    std::uint64_t h = digest(key, len, prefix);
+    std::size_t b = mix(h, 0) & (buckets - 1);
+    return slot[mix(h, disp[b]) & (slots - 1)];
+  }
+};
+
+template <fixed_value... Kw>
+[[nodiscard]] constexpr auto build() {
+
+  constexpr std::size_t n = sizeof...(Kw);
+  constexpr std::size_t chars = ((std::size(Kw.data) - 1) + ... + 0);
+
+  static_assert(n > 0, "keywords needs at least one keyword");
+  static_assert(n < 0xffff, "too many keywords");
+
+  using Table = table<n, chars>;
+
+  Table out;
+
+  std::size_t at = 0;
+  std::size_t i = 0;
+
+  auto add = [&](std::string_view kw) {
+    if (kw.empty()) {
+      throw std::invalid_argument("keywords: empty keyword");
+    }
+    std::ranges::copy(kw, out.text.begin() + static_cast<std::ptrdiff_t>(at));
+    out.offset[i] = at;
+    out.length[i] = kw.size();
+    out.first = out.first | first_set::of(static_cast<unsigned char>(kw[0]));
+    at += kw.size();
+    ++i;
+  };
+
+  (add(std::string_view{Kw.data, std::size(Kw.data) - 1}), ...);
+
+  std::vector<std::size_t> lens(out.length.begin(), out.length.end());
+  std::ranges::sort(lens, std::greater{});
+  auto [last, _] = std::ranges::unique(lens);
+  lens.erase(last, lens.end());
+
+  std::ranges::copy(lens, out.lengths.begin());
+  out.distinct = lens.size();
+
+  // The shortest prefix that, with the last byte and length, tells all apart.
+  std::vector<std::uint64_t> hs(n);
+
+  for (;; out.prefix *= 2) {
+
+    for (std::size_t k = 0; k < n; ++k) {
+      hs[k] = digest(out.key(k).data(), out.length[k], out.prefix);
+    }
+
+    std::vector<std::uint64_t> sorted = hs;
+    std::ranges::sort(sorted);
+
+    if (std::ranges::adjacent_find(sorted) == sorted.end()) {
+      break;
+    }
+
+    if (out.prefix > lens.front()) {
+      throw std::invalid_argument("keywords: duplicate keyword");
+    }
+  }
+
+  std::vector<std::vector<std::size_t>> bucket(Table::buckets);
+
+  for (std::size_t k = 0; k < n; ++k) {
+    bucket[mix(hs[k], 0) & (Table::buckets - 1)].push_back(k);
+  }
+
+  std::vector<std::size_t> order(Table::buckets);
+
+  for (std::size_t b = 0; b < order.size(); ++b) {
+    order[b] = b;
+  }
+
+  // Largest buckets first, while there are the most free slots.
+  std::ranges::sort(order, [&](std::size_t x, std::size_t y) {
+    return std::pair{bucket[y].size(), x} < std::pair{bucket[x].size(), y};
+  });
+
+  for (std::size_t b : order) {
+
+    std::uint32_t d = 1;
+
+    for (;; ++d) {
+
+      if (d == 0) {
+        throw std::invalid_argument("keywords: no perfect hash found");
+      }
+
+      std::vector<std::size_t> taken;
+
+      bool ok = true;
+
+      for (std::size_t k : bucket[b]) {
+
+        std::size_t s = mix(hs[k], d) & (Table::slots - 1);
+
+        if (out.slot[s] != 0 || std::ranges::find(taken, s) != taken.end()) {
+          ok = false;
+          break;
+        }
+
+        taken.push_back(s);
+      }
+
+      if (ok) {
+        for (std::size_t j = 0; j < taken.size(); ++j) {
+          out.slot[taken[j]] = static_cast<std::uint16_t>(bucket[b][j] + 1);
+        }
+        break;
+      }
+    }
+
+    out.disp[b] = d;
+  }
+
+  return out;
+}
+
+// ===  === //
+// ===  === //
+// ===  === //
+
+template <fixed_value... Kw>
+struct err {
+  [[nodiscard]] static constexpr auto what() -> std::string {
+
+    std::string out = "Expected a keyword in {";
+
+    ((out += std::string_view{Kw.data, std::size(Kw.data) - 1}, out += ", "), ...);
+
+    out.resize(out.size() - 2);
+
+    return out + "}";
+  }
+};
+
+template <typename S>
+concept byte_stream = recombinant_forward_range<S> && std::ranges::contiguous_range<S> &&
+                      std::ranges::sized_range<S> &&
+                      std::integral<std::ranges::range_value_t<S>> &&
+                      sizeof(std::ranges::range_value_t<S>) == 1;
+
+/**
+ * @brief Match the longest keyword at the start of the stream.
+ */
+template <fixed_value... Kw>
+struct matcher {
+
+  static constexpr auto hash = build<Kw...>();
+
+  static constexpr grammar_info grammar = {tri::no, hash.lengths[0]};
+
+  [[nodiscard]] static constexpr auto first() -> first_set { return hash.first; }
+
+  template <byte_stream S>
+  [[nodiscard]] static constexpr auto
+  operator()(S &&stream) -> resulting_t<S, std::size_t, err<Kw...>> {
+
+    using Exp = std::expected<std::size_t, err<Kw...>>;
+
+    auto beg = std::ranges::begin(stream);
+    auto end = std::ranges::end(stream);
+
+    auto const *data = std::to_address(beg);
+    auto avail = static_cast<std::size_t>(std::ranges::size(stream));
+
+    // Longest first, one hash probe and compare per distinct length.
+    for (std::size_t i = 0; i < hash.distinct; ++i) {
+
+      std::size_t len = hash.lengths[i];
+
+      if (len > avail) {
+        continue;
+      }
+
+      std::size_t idx = hash.find(data, len);
+
+      if (idx == 0 || hash.length[--idx] != len) {
+        continue;
+      }
+
+      std::string_view kw = hash.key(idx);
+
+      bool eq = std::equal(kw.begin(), kw.end(), data, [](char a, auto b) {
+        return static_cast<unsigned char>(a) == static_cast<unsigned char>(b);
+      });
+
+      if (eq) {
+        return {{std::next(beg, static_cast<std::ptrdiff_t>(len)), end}, Exp{idx}};
+      }
+    }
+
+    return {YETI_FWD(stream), Exp{std::unexpect}};
+  }
+};
+
+} // namespace impl::keyword_impl
+
+/**
+ * @brief Match the longest of the keywords `Kw...`, the value is its index.
+ *
+ * A perfect hash over a short prefix, the last byte and the length is built
+ * at compile time. Matching costs one hash probe and one compare per
+ * distinct keyword length, independent of the number of keywords. The
+ * stream must be a contiguous range of bytes, e.g.
+ *
+ *    keywords<"mul", "do", "don't">("don't()"sv) // == 2, rest "()"
+ */
+template <fixed_value... Kw>
+inline constexpr auto keywords = combinate(lift(impl::keyword_impl::matcher<Kw...>{}));
+
+} // namespace yeti
+
+#endif /* EC53C625_6402_4C31_88E0_48BDD74FE67F */
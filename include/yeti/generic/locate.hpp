@@ -0,0 +1,135 @@
+#ifndef E3A1C2D4_5B6F_4E78_9A0B_1C2D3E4F5A6B
+#define E3A1C2D4_5B6F_4E78_9A0B_1C2D3E4F5A6B
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <ranges>
+#include <string_view>
+
+/**
+ * @brief Positions in the input, computed on demand.
+ *
+ * Parsers only ever carry the unparsed stream, everything here is derived
+ * from that stream and the original input after the fact so that the happy
+ * path pays nothing.
+ */
+
+namespace yeti {
+
+/**
+ * @brief Count the `'\n'` characters in `text`.
+ *
+ * The bulk of the input is reduced in fixed size blocks with a branch-free
+ * inner loop which compilers lower to packed compares (SSE/AVX/NEON), the
+ * per-block count cannot overflow a byte. The tail is handled one-by-one.
+ */
+[[nodiscard]] constexpr auto
+count_newlines(std::string_view text) noexcept -> std::size_t {
+
+  constexpr std::size_t block = 64;
+
+  std::size_t count = 0;
+  std::size_t i = 0;
+
+  for (; i + block <= text.size(); i += block) {
+
+    unsigned char acc = 0;
+
+    for (std::size_t j = 0; j < block; ++j) {
+      acc += static_cast<unsigned char>(text[i + j] == '\n');
+    }
+
+    count += acc;
+  }
+
+  for (; i < text.size(); ++i) {
+    count += static_cast<std::size_t>(text[i] == '\n');
+  }
+
+  return count;
+}
+
+/**
+ * @brief Compute how many tokens of `input` have been consumed by a parser
+ * that left `unparsed` behind.
+ *
+ * The unparsed stream is always a suffix of the input, hence for sized
+ * ranges this is O(1), otherwise it is a walk from the start of the input.
+ */
+template <std::ranges::forward_range R, std::ranges::forward_range U>
+[[nodiscard]] constexpr auto offset_of(R const &input, U const &unparsed) -> std::size_t {
+  if constexpr (std::ranges::sized_range<R const> && std::ranges::sized_range<U const>) {
+    auto consumed = std::ranges::size(input) - std::ranges::size(unparsed);
+    return static_cast<std::size_t>(consumed);
+  } else {
+    auto first = std::ranges::begin(input);
+    auto last = std::ranges::begin(unparsed);
+    return static_cast<std::size_t>(std::ranges::distance(first, last));
+  }
+}
+
+/**
+ * @brief A human readable position in a character stream.
+ *
+ * Both `line` and `column` are one-based, `column` counts bytes.
+ */
+struct location {
+  std::size_t offset; ///< Zero-based byte offset.
+  std::size_t line;   ///< One-based line number.
+  std::size_t column; ///< One-based byte column.
+
+  friend constexpr auto operator==(location const &, location const &) -> bool = default;
+};
+
+/**
+ * @brief Translate a byte offset into a line/column `location`.
+ *
+ * This scans `input` up to `offset`, call it on the error path only.
+ */
+[[nodiscard]] constexpr auto
+locate(std::string_view input, std::size_t offset) noexcept -> location {
+
+  offset = std::min(offset, input.size());
+
+  std::string_view head = input.substr(0, offset);
+
+  std::size_t line_start = head.rfind('\n');
+
+  line_start = line_start == std::string_view::npos ? 0 : line_start + 1;
+
+  return {offset, count_newlines(head) + 1, offset - line_start + 1};
+}
+
+/**
+ * @brief Clip at most `width` bytes of the line containing `offset`.
+ *
+ * The window is centred (as far as the line allows) on `offset` and never
+ * crosses a newline, the returned view aliases `input`.
+ */
+[[nodiscard]] constexpr auto
+context(std::string_view input, std::size_t offset, std::size_t width) noexcept
+    -> std::string_view {
+
+  offset = std::min(offset, input.size());
+
+  std::size_t beg = input.substr(0, offset).rfind('\n');
+
+  beg = beg == std::string_view::npos ? 0 : beg + 1;
+
+  std::size_t end = input.find('\n', offset);
+
+  end = end == std::string_view::npos ? input.size() : end;
+
+  if (end - beg > width) {
+    std::size_t lo = offset - beg > width / 2 ? offset - width / 2 : beg;
+    beg = std::min(lo, end - width);
+    end = beg + width;
+  }
+
+  return input.substr(beg, end - beg);
+}
+
+} // namespace yeti
+
+#endif /* E3A1C2D4_5B6F_4E78_9A0B_1C2D3E4F5A6B */
@@ -0,0 +1,243 @@
+#ifndef F6C61164_7B35_4EC1_B8B0_96230ED61F04
+#define F6C61164_7B35_4EC1_B8B0_96230ED61F04
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <ranges>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "yeti/core.hpp"
+#include "yeti/core/analysis.hpp"
+#include "yeti/core/generics.hpp"
+
+/**
+ * @brief Packrat memoization.
+ */
+
+namespace yeti {
+
+namespace impl::memo_impl {
+
+// Positions in a contiguous stream are identified by address.
+template <std::ranges::contiguous_range S>
+[[nodiscard]] auto key_of(S const &stream) noexcept -> std::uintptr_t {
+  return reinterpret_cast<std::uintptr_t>(std::ranges::data(stream));
+}
+
+struct table_base {
+  table_base() = default;
+  table_base(table_base const &) = delete;
+  auto operator=(table_base const &) -> table_base & = delete;
+  virtual ~table_base() = default;
+
+  [[nodiscard]] virtual auto size() const noexcept -> std::size_t = 0;
+  virtual void clear() noexcept = 0;
+  virtual void release(std::uintptr_t before) = 0;
+};
+
+/**
+ * @brief An open-addressing (linear probing) map from position to `R`.
+ */
+template <typename R>
+class table final : public table_base {
+ public:
+  [[nodiscard]] auto find(std::uintptr_t key) const noexcept -> R const * {
+
+    if (m_slots.empty()) {
+      return nullptr;
+    }
+
+    for (std::size_t i = index(key);; i = (i + 1) & mask()) {
+      if (!m_slots[i].val) {
+        return nullptr;
+      }
+      if (m_slots[i].key == key) {
+        return &*m_slots[i].val;
+      }
+    }
+  }
+
+  void insert(std::uintptr_t key, R val) {
+
+    if (2 * (m_size + 1) > m_slots.size()) {
+      rehash(std::max<std::size_t>(16, 2 * m_slots.size()), 0);
+    }
+
+    place(key, std::move(val));
+  }
+
+  [[nodiscard]] auto size() const noexcept -> std::size_t override { return m_size; }
+
+  void clear() noexcept override {
+    m_slots.clear();
+    m_size = 0;
+  }
+
+  void release(std::uintptr_t before) override { rehash(m_slots.size(), before); }
+
+ private:
+  struct slot {
+    std::uintptr_t key = 0;
+    std::optional<R> val;
+  };
+
+  [[nodiscard]] auto mask() const noexcept -> std::size_t { return m_slots.size() - 1; }
+
+  // Fibonacci hashing, addresses are strided so the low bits are poor.
+  [[nodiscard]] auto index(std::uintptr_t key) const noexcept -> std::size_t {
+    int bits = std::countr_zero(m_slots.size());
+    return static_cast<std::size_t>((key * 0x9E3779B97F4A7C15ULL) >> (64 - bits));
+  }
+
+  void place(std::uintptr_t key, R &&val) {
+
+    std::size_t i = index(key);
+
+    while (m_slots[i].val && m_slots[i].key != key) {
+      i = (i + 1) & mask();
+    }
+
+    if (!m_slots[i].val) {
+      ++m_size;
+    }
+
+    m_slots[i].key = key;
+    m_slots[i].val.emplace(std::move(val));
+  }
+
+  // Re-insert every entry at or after `keep` into `n` slots.
+  void rehash(std::size_t n, std::uintptr_t keep) {
+
+    std::vector<slot> old = std::exchange(m_slots, std::vector<slot>(n));
+
+    m_size = 0;
+
+    for (slot &s : old) {
+      if (s.val && s.key >= keep) {
+        place(s.key, std::move(*s.val));
+      }
+    }
+  }
+
+  std::vector<slot> m_slots;
+  std::size_t m_size = 0;
+};
+
+template <typename P, typename S, typename R>
+struct memo {
+
+  using type = S;
+
+  static constexpr grammar_info grammar = grammar_of<P>;
+
+  [[no_unique_address]] P fn;
+  table<R> *cache;
+
+  [[nodiscard]] constexpr auto first() const -> first_set { return first_of(fn); }
+
+  [[nodiscard]] auto operator()(S stream) const -> R {
+
+    std::uintptr_t key = key_of(stream);
+
+    if (R const *hit = cache->find(key)) {
+      return *hit;
+    }
+
+    R res = std::invoke(fn, std::move(stream));
+
+    cache->insert(key, res);
+
+    return res;
+  }
+};
+
+} // namespace impl::memo_impl
+
+/**
+ * @brief The state shared by the `memo` parsers of one parse.
+ *
+ * A context may only be used for one input at a time, `clear` it before
+ * re-using it. It must outlive the parsers that refer to it.
+ */
+class packrat {
+ public:
+  /**
+   * @brief Forget every memoized result.
+   */
+  void clear() noexcept {
+    for (auto &t : m_tables) {
+      t->clear();
+    }
+  }
+
+  /**
+   * @brief Forget the results memoized before `rest`.
+   *
+   * Call this once the parse is committed to never backtracking before
+   * `rest`, this bounds the memory to the lookahead window.
+   */
+  template <std::ranges::contiguous_range S>
+  void release(S const &rest) {
+    for (auto &t : m_tables) {
+      t->release(impl::memo_impl::key_of(rest));
+    }
+  }
+
+  /**
+   * @brief The number of memoized results.
+   */
+  [[nodiscard]] auto size() const noexcept -> std::size_t {
+    std::size_t n = 0;
+    for (auto const &t : m_tables) {
+      n += t->size();
+    }
+    return n;
+  }
+
+  template <typename R>
+  [[nodiscard]] auto make_table() -> impl::memo_impl::table<R> * {
+    auto t = std::make_unique<impl::memo_impl::table<R>>();
+    auto *ptr = t.get();
+    m_tables.push_back(std::move(t));
+    return ptr;
+  }
+
+ private:
+  std::vector<std::unique_ptr<impl::memo_impl::table_base>> m_tables;
+};
+
+/**
+ * @brief Cache the result of `parser` at each position of the stream.
+ *
+ * Re-parsing a position (after backtracking) then costs a hash lookup,
+ * which turns the exponential behaviour of some backtracking grammars
+ * into a linear one. The stream (`S` or the static type of the parser) must
+ * be contiguous, the value and error must be copyable. Memoize the parsers
+ * that are re-tried at the same position, memoizing everything is slower.
+ */
+template <typename S = void, typename P>
+  requires parser<strip<P>>
+[[nodiscard]] auto memo(P &&parser, packrat &ctx) {
+
+  using Str = impl::else_static<S, P>;
+
+  static_assert(std::ranges::contiguous_range<Str>, "memo needs a contiguous stream");
+
+  using R = std::invoke_result_t<strip<P> const &, Str>;
+
+  return combinate(lift(impl::memo_impl::memo<strip<P>, Str, R>{
+      YETI_FWD(parser),
+      ctx.make_table<R>(),
+  }));
+}
+
+} // namespace yeti
+
+#endif /* F6C61164_7B35_4EC1_B8B0_96230ED61F04 */
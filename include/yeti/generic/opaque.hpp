@@ -0,0 +1,255 @@
+#ifndef E3EF4013_259C_4FDA_BBC7_5339FD0E5204
+#define E3EF4013_259C_4FDA_BBC7_5339FD0E5204
+
+#include <cstddef>
+#include <expected>
+#include <functional>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "yeti/core.hpp"
+#include "yeti/core/flat_variant.hpp"
+#include "yeti/core/generics.hpp"
+
+/**
+ * @brief Type erased parsers.
+ */
+
+namespace yeti {
+
+namespace impl::opaque_impl {
+
+inline constexpr std::size_t capacity = 3 * sizeof(void *);
+
+/**
+ * @brief Small parsers live in the buffer, others on the heap.
+ */
+union box {
+  void *heap;
+  alignas(void *) std::byte buf[capacity];
+};
+
+template <typename Q>
+inline constexpr bool fits = sizeof(Q) <= capacity && alignof(Q) <= alignof(void *) &&
+                             std::is_nothrow_move_constructible_v<Q>;
+
+// Copied and destroyed as bytes, hence no manager.
+template <typename Q>
+inline constexpr bool trivial = fits<Q> && std::is_trivially_copyable_v<Q>;
+
+// A move-only parser is shared, parsers are immutable once built.
+template <typename P>
+using boxed_t =
+    std::conditional_t<std::copy_constructible<P>, P, std::shared_ptr<P const>>;
+
+template <typename Q>
+[[nodiscard]] auto get(box const &b) noexcept -> Q const & {
+  if constexpr (fits<Q>) {
+    return *std::launder(reinterpret_cast<Q const *>(b.buf));
+  } else {
+    return *static_cast<Q const *>(b.heap);
+  }
+}
+
+template <typename Q>
+[[nodiscard]] auto deref(Q const &fn) noexcept -> Q const & {
+  return fn;
+}
+
+template <typename P>
+[[nodiscard]] auto deref(std::shared_ptr<P const> const &fn) noexcept -> P const & {
+  return *fn;
+}
+
+enum class op { copy, move, destroy };
+
+/**
+ * @brief Copy/move `src` into `dst` or destroy `dst`.
+ *
+ * A move leaves `src` to be forgotten, not destroyed.
+ */
+template <typename Q>
+void manage(op what, box &dst, box const &src) {
+  if constexpr (fits<Q>) {
+    switch (what) {
+      case op::copy:
+        std::construct_at(reinterpret_cast<Q *>(dst.buf), get<Q>(src));
+        return;
+      case op::move: {
+        auto &from = const_cast<Q &>(get<Q>(src));
+        std::construct_at(reinterpret_cast<Q *>(dst.buf), std::move(from));
+        std::destroy_at(std::addressof(from));
+        return;
+      }
+      case op::destroy:
+        std::destroy_at(std::addressof(get<Q>(dst)));
+        return;
+    }
+  } else {
+    switch (what) {
+      case op::copy:
+        dst.heap = new Q(get<Q>(src));
+        return;
+      case op::move:
+        dst.heap = src.heap;
+        return;
+      case op::destroy:
+        delete std::addressof(get<Q>(dst));
+        return;
+    }
+  }
+}
+
+// Invoke the stored parser and convert to the fixed result.
+template <typename S, typename T, typename E, typename Q>
+auto call(box const &b, S stream) -> result<S, T, E> {
+
+  auto [rest, res] = std::invoke(deref(get<Q>(b)), std::move(stream));
+
+  using Exp = std::expected<T, E>;
+
+  if (res) {
+    return {std::move(rest), Exp{std::in_place, flat_cast<T>(std::move(res).value())}};
+  }
+
+  return {std::move(rest), Exp{std::unexpect, flat_cast<E>(std::move(res).error())}};
+}
+
+/**
+ * @brief A parser over `S` producing `T` or `E`, whatever its structure.
+ *
+ * Costs one indirect call per invocation, parsers that do not fit in the
+ * buffer (or that are not nothrow movable) are allocated on the heap.
+ * A moved-from `erased` must not be invoked.
+ */
+template <typename S, typename T, typename E>
+class erased {
+ public:
+  using type = S;
+
+  template <typename P>
+    requires (!std::same_as<strip<P>, erased>) && parser<strip<P>, S>
+  explicit erased(P &&parser) {
+
+    using Q = boxed_t<strip<P>>;
+
+    if constexpr (std::copy_constructible<strip<P>>) {
+      emplace<Q>(YETI_FWD(parser));
+    } else {
+      emplace<Q>(std::make_shared<strip<P> const>(YETI_FWD(parser)));
+    }
+
+    m_call = &call<S, T, E, Q>;
+
+    if constexpr (!trivial<Q>) {
+      m_manage = &manage<Q>;
+    }
+  }
+
+  erased(erased const &other) : m_call{other.m_call}, m_manage{other.m_manage} {
+    if (m_manage) {
+      m_manage(op::copy, m_box, other.m_box);
+    } else {
+      m_box = other.m_box;
+    }
+  }
+
+  erased(erased &&other) noexcept : m_call{other.m_call}, m_manage{other.m_manage} {
+    if (m_manage) {
+      m_manage(op::move, m_box, other.m_box);
+    } else {
+      m_box = other.m_box;
+    }
+    other.m_call = nullptr;
+    other.m_manage = nullptr;
+  }
+
+  auto operator=(erased other) noexcept -> erased & {
+    reset();
+    std::construct_at(this, std::move(other));
+    return *this;
+  }
+
+  ~erased() { reset(); }
+
+  [[nodiscard]] auto operator()(S stream) const -> result<S, T, E> {
+    return m_call(m_box, std::move(stream));
+  }
+
+ private:
+  template <typename Q, typename... Args>
+  void emplace(Args &&...args) {
+    if constexpr (fits<Q>) {
+      std::construct_at(reinterpret_cast<Q *>(m_box.buf), YETI_FWD(args)...);
+    } else {
+      m_box.heap = new Q(YETI_FWD(args)...);
+    }
+  }
+
+  void reset() noexcept {
+    if (m_manage) {
+      m_manage(op::destroy, m_box, m_box);
+    }
+    m_manage = nullptr;
+  }
+
+  auto (*m_call)(box const &, S) -> result<S, T, E> = nullptr;
+  void (*m_manage)(op, box &, box const &) = nullptr;
+  box m_box;
+};
+
+} // namespace impl::opaque_impl
+
+/**
+ * @brief The type of `opaque<S, T, E>(p)` for any `p`.
+ *
+ * Name it in a header to compile a piece of a grammar separately:
+ *
+ * @code
+ * auto number() -> opaque_t<std::string_view, int, bad_number>;
+ * @endcode
+ */
+template <typename S, std::movable T, error E>
+using opaque_t = decltype(combinate(lift(
+    std::declval<impl::opaque_impl::erased<S, T, E>>())));
+
+/**
+ * @brief Hide the structure of `parser` behind an erasure boundary.
+ *
+ * The result is a parser over `S` (by default the static stream type of
+ * `parser`) of the same value and error types, whose type does not depend
+ * on the combinators `parser` was built from. The boundary stops template
+ * instantiation, symbol growth and inlining: it costs one indirect call per
+ * invocation, allocation only if `parser` is larger than three pointers,
+ * and `parser` is opaque to analysis, simplification and fusion.
+ *
+ * A move-only `parser` is shared by the copies of the result.
+ */
+template <typename S = void, typename P>
+  requires (!std::is_void_v<impl::else_static<S, strip<P>>>) && parser<strip<P>, S>
+[[nodiscard]] auto opaque(P &&parser) {
+
+  using Sp = impl::else_static<S, strip<P>>;
+  using T = parse_value_t<strip<P>, S>;
+  using E = parse_error_t<strip<P>, S>;
+
+  return combinate(lift(impl::opaque_impl::erased<Sp, T, E>{YETI_FWD(parser)}));
+}
+
+/**
+ * @brief As above but converts to the declared value and error types.
+ *
+ * The values and errors of `parser` are converted with `flat_cast`, hence
+ * parsers of the same declared types share one type, `opaque_t<S, T, E>`.
+ */
+template <typename S, std::movable T, error E, typename P>
+  requires parser<strip<P>, S>
+[[nodiscard]] auto opaque(P &&parser) -> opaque_t<S, T, E> {
+  return combinate(lift(impl::opaque_impl::erased<S, T, E>{YETI_FWD(parser)}));
+}
+
+} // namespace yeti
+
+#endif /* E3EF4013_259C_4FDA_BBC7_5339FD0E5204 */
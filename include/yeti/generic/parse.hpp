@@ -0,0 +1,106 @@
+#ifndef F41B7C2A_9D3E_4A5F_8B6C_7D8E9F0A1B2C
+#define F41B7C2A_9D3E_4A5F_8B6C_7D8E9F0A1B2C
+
+#include <concepts>
+#include <cstddef>
+#include <expected>
+#include <format>
+#include <functional>
+#include <ranges>
+#include <string>
+#include <string_view>
+
+#include "yeti/core.hpp"
+#include "yeti/core/generics.hpp"
+#include "yeti/core/parser_fn.hpp"
+#include "yeti/generic/locate.hpp"
+
+/**
+ * @brief Top level drivers, these turn a parser into a value or a located error.
+ */
+
+namespace yeti {
+
+/**
+ * @brief A parse error decorated with where in the input it happened.
+ *
+ * Only the offset is computed when the parse fails, the line, column and
+ * context are derived from it when (and if) the error is rendered.
+ *
+ * @tparam S The type of the input stream, this is held by value (a view).
+ * @tparam E The error type of the parser.
+ */
+template <typename S, error E>
+struct failure {
+
+  /**
+   * @brief The number of bytes of context `what` includes.
+   */
+  static constexpr std::size_t context_width = 64;
+
+  [[no_unique_address]] E reason; ///< The error the parser produced.
+  [[no_unique_address]] S input;  ///< The input the parser was given.
+  std::size_t offset;             ///< Tokens consumed before the error.
+
+  /**
+   * @brief Compute the line and column of the error.
+   */
+  [[nodiscard]] constexpr auto where() const noexcept -> location
+    requires std::convertible_to<S const &, std::string_view>
+  {
+    return locate(input, offset);
+  }
+
+  /**
+   * @brief Render the error with at most `width` bytes of context.
+   */
+  [[nodiscard]] constexpr auto render(std::size_t width) const -> std::string {
+    if constexpr (std::convertible_to<S const &, std::string_view>) {
+
+      std::string_view text = input;
+
+      location loc = locate(text, offset);
+
+      std::string_view ctx = context(text, offset, width);
+
+      auto caret = offset - static_cast<std::size_t>(ctx.data() - text.data());
+
+      constexpr std::string_view fmt = "{}:{}: {}\n\t{}\n\t{:>{}}";
+
+      return std::format(
+          fmt, loc.line, loc.column, auto(reason).what(), ctx, '^', caret + 1);
+    } else {
+      return std::format("At token {}: {}", offset, auto(reason).what());
+    }
+  }
+
+  [[nodiscard]] constexpr auto what() const -> std::string {
+    return render(context_width);
+  }
+};
+
+/**
+ * @brief Run `parser` over `input`, locating the error if it fails.
+ *
+ * On success this costs exactly one invocation of the parser, on failure the
+ * offset is recovered by comparing the unparsed stream against `input`.
+ */
+template <typename P, std::ranges::forward_range S>
+  requires parser_fn<P, S>
+[[nodiscard]] constexpr auto parse(P &&parser, S const &input)
+    -> std::expected<parse_value_t<P, S>, failure<S, parse_error_t<P, S>>> {
+
+  auto [rest, result] = std::invoke(YETI_FWD(parser), auto(input));
+
+  if (result) {
+    return std::move(result).value();
+  }
+
+  using F = failure<S, parse_error_t<P, S>>;
+
+  return std::unexpected(F{std::move(result).error(), input, offset_of(input, rest)});
+}
+
+} // namespace yeti
+
+#endif /* F41B7C2A_9D3E_4A5F_8B6C_7D8E9F0A1B2C */
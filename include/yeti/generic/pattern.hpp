@@ -0,0 +1,697 @@
+#ifndef F5DC88AE_F9CB_4484_BC2B_C1BA5886C8F9
+#define F5DC88AE_F9CB_4484_BC2B_C1BA5886C8F9
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <format>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <ranges>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "yeti/core.hpp"
+#include "yeti/core/analysis.hpp"
+#include "yeti/core/combinate/fixed.hpp"
+#include "yeti/core/generics.hpp"
+#include "yeti/generic/segmented.hpp"
+
+/**
+ * @brief Regular expressions compiled to a DFA at compile time.
+ */
+
+namespace yeti {
+
+namespace impl::pattern_impl {
+
+// ===  === //
+// ===  === //
+// ===  === //
+
+// Thompson NFA node, a transition on `set` to `out` and/or two epsilons.
+struct node {
+  first_set set;
+  int out = -1;
+  int eps1 = -1;
+  int eps2 = -1;
+};
+
+struct fragment {
+  int start;
+  int end;
+};
+
+/**
+ * @brief Recursive descent over the pattern building a Thompson NFA.
+ *
+ * Supports literals, `.`, `[...]`/`[^...]` classes with ranges, the escapes
+ * `\d \w \s \D \W \S` and escaped metacharacters, `(...)`, `|`, `*`, `+`
+ * and `?`. Errors throw which, at compile time, is a compile error.
+ */
+class reader {
+ public:
+  constexpr explicit reader(std::string_view pat) : m_pat{pat} {}
+
+  [[nodiscard]] constexpr auto build() -> std::pair<std::vector<node>, fragment> {
+
+    fragment frag = alternation();
+
+    if (m_pos != m_pat.size()) {
+      throw std::invalid_argument("pattern: unbalanced ')'");
+    }
+
+    return {std::move(m_nodes), frag};
+  }
+
+ private:
+  std::string_view m_pat;
+  std::size_t m_pos = 0;
+  std::vector<node> m_nodes;
+
+  [[nodiscard]] constexpr auto done() const -> bool { return m_pos == m_pat.size(); }
+
+  [[nodiscard]] constexpr auto peek() const -> char { return m_pat[m_pos]; }
+
+  constexpr auto next() -> char {
+    if (done()) {
+      throw std::invalid_argument("pattern: unexpected end");
+    }
+    return m_pat[m_pos++];
+  }
+
+  constexpr auto make() -> int {
+    m_nodes.push_back({});
+    return static_cast<int>(m_nodes.size() - 1);
+  }
+
+  constexpr auto empty() -> fragment {
+    int n = make();
+    return {n, n};
+  }
+
+  constexpr auto single(first_set const &set) -> fragment {
+    int beg = make();
+    int end = make();
+    m_nodes[beg].set = set;
+    m_nodes[beg].out = end;
+    return {beg, end};
+  }
+
+  constexpr auto alternation() -> fragment {
+
+    fragment lhs = sequence();
+
+    while (!done() && peek() == '|') {
+
+      ++m_pos;
+
+      fragment rhs = sequence();
+
+      int beg = make();
+      int end = make();
+
+      m_nodes[beg].eps1 = lhs.start;
+      m_nodes[beg].eps2 = rhs.start;
+      m_nodes[lhs.end].eps1 = end;
+      m_nodes[rhs.end].eps1 = end;
+
+      lhs = {beg, end};
+    }
+
+    return lhs;
+  }
+
+  constexpr auto sequence() -> fragment {
+
+    fragment acc = empty();
+
+    while (!done() && peek() != '|' && peek() != ')') {
+      fragment rhs = repeat();
+      m_nodes[acc.end].eps1 = rhs.start;
+      acc.end = rhs.end;
+    }
+
+    return acc;
+  }
+
+  constexpr auto repeat() -> fragment {
+
+    fragment frag = atom();
+
+    while (!done() && (peek() == '*' || peek() == '+' || peek() == '?')) {
+
+      char op = next();
+
+      int beg = make();
+      int end = make();
+
+      m_nodes[beg].eps1 = frag.start;
+      m_nodes[frag.end].eps1 = end;
+
+      if (op != '+') {
+        m_nodes[beg].eps2 = end;
+      }
+
+      if (op != '?') {
+        m_nodes[frag.end].eps2 = frag.start;
+      }
+
+      frag = {beg, end};
+    }
+
+    return frag;
+  }
+
+  constexpr auto atom() -> fragment {
+
+    char c = next();
+
+    switch (c) {
+      case '(': {
+        fragment inner = alternation();
+        if (done() || next() != ')') {
+          throw std::invalid_argument("pattern: unbalanced '('");
+        }
+        return inner;
+      }
+      case '[':
+        return single(bracket());
+      case '.':
+        return single(complement(first_set::of('\n')));
+      case '\\':
+        return single(escape(next()));
+      case '*':
+      case '+':
+      case '?':
+        throw std::invalid_argument("pattern: nothing to repeat");
+      default:
+        return single(first_set::of(static_cast<unsigned char>(c)));
+    }
+  }
+
+  [[nodiscard]] static constexpr auto complement(first_set set) -> first_set {
+    for (auto &word : set.bits) {
+      word = ~word;
+    }
+    return set;
+  }
+
+  [[nodiscard]] static constexpr auto
+  range(unsigned char lo, unsigned char hi) -> first_set {
+
+    if (lo > hi) {
+      throw std::invalid_argument("pattern: reversed range");
+    }
+
+    first_set set;
+
+    for (int i = lo; i <= hi; ++i) {
+      set = set | first_set::of(static_cast<unsigned char>(i));
+    }
+
+    return set;
+  }
+
+  [[nodiscard]] static constexpr auto escape(char c) -> first_set {
+    switch (c) {
+      case 'd':
+        return range('0', '9');
+      case 'w':
+        return range('a', 'z') | range('A', 'Z') | range('0', '9') | first_set::of('_');
+      case 's':
+        return range('\t', '\r') | first_set::of(' ');
+      case 'D':
+      case 'W':
+      case 'S':
+        return complement(escape(static_cast<char>(c - 'A' + 'a')));
+      case 'n':
+        return first_set::of('\n');
+      case 'r':
+        return first_set::of('\r');
+      case 't':
+        return first_set::of('\t');
+      default:
+        break;
+    }
+
+    // Only punctuation escapes to itself, e.g. `\b` or `\x41` are not literals.
+    bool alpha = (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z');
+    bool digit = c >= '0' && c <= '9';
+
+    if (alpha || digit || c < '!' || c > '~') {
+      throw std::invalid_argument("pattern: unknown escape");
+    }
+
+    return first_set::of(static_cast<unsigned char>(c));
+  }
+
+  constexpr auto bracket() -> first_set {
+
+    bool negate = !done() && peek() == '^';
+
+    if (negate) {
+      ++m_pos;
+    }
+
+    first_set set;
+
+    // A leading ']' is a literal.
+    for (bool first = true; first || peek() != ']'; first = false) {
+
+      char c = next();
+
+      bool ranged = m_pos + 1 < m_pat.size() && peek() == '-' && m_pat[m_pos + 1] != ']';
+
+      if (c == '\\') {
+        set = set | escape(next());
+      } else if (ranged) {
+        ++m_pos;
+        auto hi = static_cast<unsigned char>(next());
+        set = set | range(static_cast<unsigned char>(c), hi);
+      } else {
+        set = set | first_set::of(static_cast<unsigned char>(c));
+      }
+
+      // Also after an escape, the loop condition peeks.
+      if (done()) {
+        throw std::invalid_argument("pattern: unbalanced '['");
+      }
+    }
+
+    ++m_pos;
+
+    return negate ? complement(set) : set;
+  }
+};
+
+// ===  === //
+// ===  === //
+// ===  === //
+
+using state = std::uint16_t;
+
+// A set of NFA nodes.
+using subset = std::vector<bool>;
+
+/**
+ * @brief A DFA over byte classes, state 0 is dead.
+ */
+struct dfa {
+  std::array<std::uint8_t, 256> cls{};
+  std::size_t classes = 0;
+  std::vector<std::vector<state>> next;
+  std::vector<bool> accept;
+  state start = 1;
+};
+
+constexpr void closure(std::vector<node> const &nfa, subset &set, int n) {
+
+  if (n < 0 || set[static_cast<std::size_t>(n)]) {
+    return;
+  }
+
+  set[static_cast<std::size_t>(n)] = true;
+
+  closure(nfa, set, nfa[static_cast<std::size_t>(n)].eps1);
+  closure(nfa, set, nfa[static_cast<std::size_t>(n)].eps2);
+}
+
+// Partition the bytes into classes no transition distinguishes between.
+constexpr auto byte_classes(std::vector<node> const &nfa, dfa &out) -> std::vector<int> {
+
+  std::vector<int> rep;
+
+  for (int b = 0; b < 256; ++b) {
+
+    auto same = [&](int r) {
+      for (node const &n : nfa) {
+        if (n.out >= 0 && n.set.contains(static_cast<unsigned char>(b)) !=
+                              n.set.contains(static_cast<unsigned char>(r))) {
+          return false;
+        }
+      }
+      return true;
+    };
+
+    std::size_t k = 0;
+
+    while (k < rep.size() && !same(rep[k])) {
+      ++k;
+    }
+
+    if (k == rep.size()) {
+      rep.push_back(b);
+    }
+
+    out.cls[static_cast<std::size_t>(b)] = static_cast<std::uint8_t>(k);
+  }
+
+  out.classes = rep.size();
+
+  return rep;
+}
+
+// Subset construction.
+constexpr auto determinize(std::vector<node> const &nfa, fragment frag) -> dfa {
+
+  dfa out;
+
+  std::vector<int> rep = byte_classes(nfa, out);
+
+  std::vector<subset> sets;
+
+  sets.emplace_back(nfa.size(), false); // Dead.
+  sets.emplace_back(nfa.size(), false);
+
+  closure(nfa, sets[1], frag.start);
+
+  for (std::size_t s = 0; s < sets.size(); ++s) {
+
+    out.next.emplace_back(out.classes, state{0});
+    out.accept.push_back(sets[s][static_cast<std::size_t>(frag.end)]);
+
+    for (std::size_t k = 0; k < out.classes; ++k) {
+
+      subset move(nfa.size(), false);
+
+      for (std::size_t i = 0; i < nfa.size(); ++i) {
+        if (sets[s][i] && nfa[i].out >= 0 &&
+            nfa[i].set.contains(static_cast<unsigned char>(rep[k]))) {
+          closure(nfa, move, nfa[i].out);
+        }
+      }
+
+      std::size_t t = 0;
+
+      while (t < sets.size() && sets[t] != move) {
+        ++t;
+      }
+
+      if (t == sets.size()) {
+        sets.push_back(std::move(move));
+      }
+
+      if (t > std::numeric_limits<state>::max()) {
+        throw std::invalid_argument("pattern: too many states");
+      }
+
+      out.next[s][k] = static_cast<state>(t);
+    }
+  }
+
+  return out;
+}
+
+// Moore's partition refinement, keeps the dead state at 0.
+constexpr auto minimize(dfa const &in) -> dfa {
+
+  std::size_t n = in.next.size();
+
+  std::vector<std::size_t> block(n);
+
+  for (std::size_t s = 0; s < n; ++s) {
+    block[s] = in.accept[s] ? 1 : 0;
+  }
+
+  for (std::size_t count = 0;;) {
+
+    // A state's signature is its block and the blocks it moves to.
+    std::vector<std::vector<std::size_t>> sigs;
+    std::vector<std::size_t> next_block(n);
+
+    for (std::size_t s = 0; s < n; ++s) {
+
+      std::vector<std::size_t> sig{block[s]};
+
+      for (state t : in.next[s]) {
+        sig.push_back(block[t]);
+      }
+
+      std::size_t k = 0;
+
+      while (k < sigs.size() && sigs[k] != sig) {
+        ++k;
+      }
+
+      if (k == sigs.size()) {
+        sigs.push_back(std::move(sig));
+      }
+
+      next_block[s] = k;
+    }
+
+    block = std::move(next_block);
+
+    if (sigs.size() == count) {
+      break;
+    }
+
+    count = sigs.size();
+  }
+
+  // Number the blocks such that the dead state's is 0.
+  std::vector<std::size_t> order(n, n);
+  std::size_t blocks = 0;
+
+  for (std::size_t s = 0; s < n; ++s) {
+    if (order[block[s]] == n) {
+      order[block[s]] = blocks++;
+    }
+  }
+
+  dfa out;
+
+  out.cls = in.cls;
+  out.classes = in.classes;
+  out.next.resize(blocks);
+  out.accept.resize(blocks);
+  out.start = static_cast<state>(order[block[in.start]]);
+
+  for (std::size_t s = 0; s < n; ++s) {
+
+    std::size_t b = order[block[s]];
+
+    out.accept[b] = in.accept[s];
+    out.next[b].clear();
+
+    for (state t : in.next[s]) {
+      out.next[b].push_back(static_cast<state>(order[block[t]]));
+    }
+  }
+
+  return out;
+}
+
+[[nodiscard]] constexpr auto compile(std::string_view pat) -> dfa {
+  auto [nfa, frag] = reader{pat}.build();
+  return minimize(determinize(nfa, frag));
+}
+
+/**
+ * @brief The frozen DFA, `loop[s]` are the bytes on which `s` stays put.
+ */
+template <std::size_t States, std::size_t Classes>
+struct table {
+  std::array<std::uint8_t, 256> cls;
+  std::array<std::array<state, Classes>, States> next;
+  std::array<bool, States> accept;
+  std::array<first_set, States> loop;
+  first_set first;
+  state start;
+};
+
+template <std::size_t States, std::size_t Classes>
+[[nodiscard]] constexpr auto freeze(dfa const &in) -> table<States, Classes> {
+
+  table<States, Classes> out{};
+
+  out.cls = in.cls;
+  out.start = in.start;
+
+  for (std::size_t s = 0; s < States; ++s) {
+
+    out.accept[s] = in.accept[s];
+
+    for (std::size_t k = 0; k < Classes; ++k) {
+      out.next[s][k] = in.next[s][k];
+    }
+
+    for (int b = 0; b < 256; ++b) {
+
+      state t = in.next[s][in.cls[static_cast<std::size_t>(b)]];
+
+      if (s != 0 && t == s) {
+        out.loop[s] = out.loop[s] | first_set::of(static_cast<unsigned char>(b));
+      }
+
+      if (s == in.start && t != 0) {
+        out.first = out.first | first_set::of(static_cast<unsigned char>(b));
+      }
+    }
+  }
+
+  return out;
+}
+
+template <fixed_value Pat>
+inline constexpr std::string_view source{Pat.data, std::size(Pat.data) - 1};
+
+template <fixed_value Pat>
+inline constexpr auto shape = [] {
+  dfa d = compile(source<Pat>);
+  return std::pair{d.next.size(), d.classes};
+}();
+
+template <fixed_value Pat>
+inline constexpr auto compiled =
+    freeze<shape<Pat>.first, shape<Pat>.second>(compile(source<Pat>));
+
+// ===  === //
+// ===  === //
+// ===  === //
+
+template <fixed_value Pat>
+struct err {
+  [[nodiscard]] static constexpr auto what() -> std::string {
+    return std::format("Expected pattern={}", source<Pat>);
+  }
+};
+
+template <typename S>
+concept byte_stream = recombinant_forward_range<S> &&
+                      std::integral<std::ranges::range_value_t<S>> &&
+                      sizeof(std::ranges::range_value_t<S>) == 1;
+
+/**
+ * @brief Match the longest prefix of the stream in the pattern's language.
+ */
+template <fixed_value Pat>
+struct matcher {
+
+  static constexpr auto const &automaton = compiled<Pat>;
+
+  static constexpr grammar_info grammar = {
+      automaton.accept[automaton.start] ? tri::yes : tri::no,
+      grammar_info::unbounded,
+  };
+
+  [[nodiscard]] static constexpr auto first() -> first_set { return automaton.first; }
+
+  template <byte_stream S>
+  [[nodiscard]] static constexpr auto
+  operator()(S &&stream) -> resulting_t<S, strip<S>, err<Pat>> {
+
+    using Exp = std::expected<strip<S>, err<Pat>>;
+
+    auto beg = std::ranges::begin(stream);
+    auto end = std::ranges::end(stream);
+
+    auto byte = [](auto tok) static {
+      return static_cast<unsigned char>(tok);
+    };
+
+    state cur = automaton.start;
+
+    bool ok = automaton.accept[cur];
+
+    auto it = beg;
+    auto last = beg;
+
+    while (it != end) {
+
+      state nxt = automaton.next[cur][automaton.cls[byte(*it)]];
+
+      if (nxt == 0) {
+        break;
+      }
+
+      ++it;
+
+      // Runs of a self-looping class, e.g. the tail of an identifier.
+      if (nxt == cur) {
+        if constexpr (std::ranges::contiguous_range<S>) {
+
+          auto const *ptr = std::to_address(it);
+          auto const *lim = ptr + std::ranges::distance(it, end);
+          auto const *run = ptr;
+
+          while (run != lim && automaton.loop[cur].contains(byte(*run))) {
+            ++run;
+          }
+
+          std::ranges::advance(it, run - ptr);
+
+        } else if constexpr (segmented_range<S>) {
+
+          auto loops = [cur, byte](auto tok) {
+            return automaton.loop[cur].contains(byte(tok));
+          };
+
+          for (;;) {
+
+            strip<S> rest{it, end};
+
+            auto seg = rest.segment();
+            auto stop = std::ranges::find_if_not(seg, loops);
+            auto n = static_cast<std::size_t>(stop - std::ranges::begin(seg));
+
+            it = rest.drop(n).begin();
+
+            if (n < std::ranges::size(seg) || n == 0) {
+              break;
+            }
+          }
+
+        } else {
+          while (it != end && automaton.loop[cur].contains(byte(*it))) {
+            ++it;
+          }
+        }
+      }
+
+      cur = nxt;
+
+      if (automaton.accept[cur]) {
+        ok = true;
+        last = it;
+      }
+    }
+
+    if (!ok) {
+      return {YETI_FWD(stream), Exp{std::unexpect}};
+    }
+
+    return {{last, end}, Exp{std::in_place, beg, last}};
+  }
+};
+
+} // namespace impl::pattern_impl
+
+/**
+ * @brief Match a regular expression, the value is the matched subrange.
+ *
+ * The pattern is compiled to a minimal DFA at compile time and matched
+ * greedily (longest match) with a table driven loop. Matching is zero copy,
+ * the value is the stream type constructed from the matched iterators. The
+ * stream must be a forward range of bytes.
+ *
+ * Supported: literals, `.` (any byte but `\n`), `[a-z_]`/`[^...]`,
+ * `\d \w \s \D \W \S \n \r \t`, escaped punctuation, grouping, `|`, `*`, `+`
+ * and `?`. Other escapes (e.g. `\b`, `\x41`) are rejected. e.g.
+ *
+ *    pattern<"[a-zA-Z_]\\w*">                  // identifiers
+ *    pattern<"\\d\\d\\d\\d-\\d\\d-\\d\\d">     // dates
+ *    pattern<"0[xX][0-9a-fA-F]+">              // hex literals
+ */
+template <fixed_value Pat>
+inline constexpr auto pattern = combinate(lift(impl::pattern_impl::matcher<Pat>{}));
+
+} // namespace yeti
+
+#endif /* F5DC88AE_F9CB_4484_BC2B_C1BA5886C8F9 */
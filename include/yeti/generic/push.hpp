@@ -0,0 +1,261 @@
+#ifndef B7F20C94_3E5A_4D61_A8C7_1E9B4F6D2A05
+#define B7F20C94_3E5A_4D61_A8C7_1E9B4F6D2A05
+
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <optional>
+#include <ranges>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include "yeti/core.hpp"
+#include "yeti/core/generics.hpp"
+#include "yeti/core/parser_fn.hpp"
+#include "yeti/generic/parse.hpp"
+
+namespace yeti {
+
+/**
+ * @brief A view of `S` that records if a parser tested for its end.
+ *
+ * The buffered input of a `pusher` ends where the last chunk ended, a parser
+ * that found the end may have stopped only for want of the next chunk. The
+ * flag must outlive the stream.
+ */
+template <std::ranges::forward_range S>
+class partial {
+ public:
+  using base_iterator = std::ranges::iterator_t<S>;
+  using base_sentinel = std::ranges::sentinel_t<S>;
+
+  class sentinel {
+   public:
+    sentinel() = default;
+
+    constexpr explicit sentinel(base_sentinel end) : m_end{std::move(end)} {}
+
+    [[nodiscard]] constexpr auto base() const -> base_sentinel const & { return m_end; }
+
+   private:
+    base_sentinel m_end;
+  };
+
+  class iterator {
+   public:
+    using value_type = std::iter_value_t<base_iterator>;
+    using difference_type = std::iter_difference_t<base_iterator>;
+
+    iterator() = default;
+
+    constexpr iterator(base_iterator it, bool *hit) : m_it{std::move(it)}, m_hit{hit} {}
+
+    constexpr auto operator*() const -> std::iter_reference_t<base_iterator> {
+      return *m_it;
+    }
+
+    constexpr auto operator++() -> iterator & {
+      ++m_it;
+      return *this;
+    }
+
+    constexpr auto operator++(int) -> iterator {
+      auto tmp = *this;
+      ++m_it;
+      return tmp;
+    }
+
+    [[nodiscard]] constexpr auto base() const -> base_iterator const & { return m_it; }
+
+    friend constexpr auto operator==(iterator const &lhs, iterator const &rhs) -> bool {
+      return lhs.m_it == rhs.m_it;
+    }
+
+    friend constexpr auto operator==(iterator const &it, sentinel const &end) -> bool {
+
+      if (it.m_it == end.base()) {
+        *it.m_hit = true;
+        return true;
+      }
+
+      return false;
+    }
+
+   private:
+    base_iterator m_it{};
+    bool *m_hit = nullptr;
+  };
+
+  partial() = default;
+
+  constexpr partial(S const &stream, bool &hit)
+      : m_beg{std::ranges::begin(stream), &hit},
+        m_end{std::ranges::end(stream)} {}
+
+  constexpr partial(iterator beg, sentinel end)
+      : m_beg{std::move(beg)},
+        m_end{std::move(end)} {}
+
+  [[nodiscard]] constexpr auto begin() const -> iterator { return m_beg; }
+
+  [[nodiscard]] constexpr auto end() const -> sentinel { return m_end; }
+
+  [[nodiscard]] constexpr auto empty() const -> bool { return m_beg == m_end; }
+
+  /**
+   * @brief The same position in the underlying stream.
+   */
+  [[nodiscard]] constexpr auto base() const -> S { return S{m_beg.base(), m_end.base()}; }
+
+ private:
+  iterator m_beg;
+  sentinel m_end;
+};
+
+/**
+ * @brief The state of a `pusher` after it has been fed.
+ */
+enum class push_status {
+  ready,     ///< Every byte fed so far has been parsed into records.
+  need_more, ///< A partial record is buffered, feed more input.
+  stalled,   ///< A record parsed without consuming input, more input cannot help.
+  failed,    ///< A record failed to parse, see `pusher::error`.
+};
+
+/**
+ * @brief Drive a record parser with input that arrives in chunks.
+ *
+ * Chunks are appended to an internal buffer from which complete records are
+ * parsed and handed to `sink`. Only the unconsumed tail of the input is
+ * retained between calls to `feed`.
+ *
+ * The parser is invoked with a `partial` view of the buffer (typed parsers
+ * must be declared over `partial<std::string_view>`). An outcome is only
+ * final if the parser never tested for the end of the buffered input: a
+ * success that did may still be extended by the next chunk (e.g. a number)
+ * and a failure that did may just be missing input, whatever the unparsed
+ * rest an alternative reports. Both suspend the driver (`need_more`) and the
+ * record is re-parsed from its start once more input is fed. After `finish`
+ * all outcomes are final.
+ */
+template <typename P, typename F>
+  requires parser_fn<P, partial<std::string_view>> &&
+           std::invocable<F &, parse_value_t<P, partial<std::string_view>>>
+class pusher {
+ public:
+  using stream_type = partial<std::string_view>;
+
+  using failure_type = failure<std::string_view, parse_error_t<P, stream_type>>;
+
+  constexpr pusher(P parser, F sink)
+      : m_parser{std::move(parser)},
+        m_sink{std::move(sink)} {}
+
+  /**
+   * @brief Append `chunk` to the input and parse every complete record.
+   */
+  constexpr auto feed(std::string_view chunk) -> push_status {
+
+    if (m_error) {
+      return push_status::failed;
+    }
+
+    m_buffer.append(chunk);
+
+    return drain(false);
+  }
+
+  /**
+   * @brief Signal the end of the input and parse what remains.
+   *
+   * Never returns `need_more`, a record that stops short of the end without
+   * consuming input is `stalled`.
+   */
+  constexpr auto finish() -> push_status {
+
+    if (m_error) {
+      return push_status::failed;
+    }
+
+    return drain(true);
+  }
+
+  /**
+   * @brief The error that stopped the driver, relative to the retained buffer.
+   */
+  [[nodiscard]] constexpr auto
+  error() const noexcept -> std::optional<failure_type> const & {
+    return m_error;
+  }
+
+  /**
+   * @brief The number of bytes released from the front of the input.
+   *
+   * Add this to `error()->offset` for the offset in the whole input.
+   */
+  [[nodiscard]] constexpr auto released() const noexcept -> std::size_t {
+    return m_released;
+  }
+
+ private:
+  constexpr auto drain(bool last) -> push_status {
+
+    std::string_view buffer{m_buffer};
+    std::string_view window = buffer.substr(m_head);
+
+    push_status status = push_status::ready;
+
+    while (!window.empty()) {
+
+      bool hit = false;
+
+      auto [rest, result] = std::invoke(m_parser, stream_type{window, hit});
+
+      std::string_view left = rest.base();
+
+      if (hit && !last) {
+        status = push_status::need_more; // This record may continue in the next chunk.
+        break;
+      }
+
+      if (!result) {
+        // The buffer is not touched again, the failure may view all of it.
+        m_error.emplace(std::move(result).error(), buffer, buffer.size() - left.size());
+        return push_status::failed;
+      }
+
+      if (left.size() == window.size()) {
+        status = push_status::stalled;
+        break;
+      }
+
+      std::invoke(m_sink, std::move(result).value());
+
+      window = left;
+    }
+
+    m_head = m_buffer.size() - window.size();
+
+    // Compact lazily such that releasing is amortised O(1) per byte.
+    if (2 * m_head >= m_buffer.size()) {
+      m_buffer.erase(0, m_head);
+      m_released += m_head;
+      m_head = 0;
+    }
+
+    return status;
+  }
+
+  [[no_unique_address]] P m_parser;
+  [[no_unique_address]] F m_sink;
+  std::string m_buffer;
+  std::size_t m_head = 0;
+  std::size_t m_released = 0;
+  std::optional<failure_type> m_error;
+};
+
+} // namespace yeti
+
+#endif /* B7F20C94_3E5A_4D61_A8C7_1E9B4F6D2A05 */
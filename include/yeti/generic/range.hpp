@@ -1,9 +1,13 @@
 #ifndef BCC882F7_ED8D_4A23_B468_977755EA6D56
 #define BCC882F7_ED8D_4A23_B468_977755EA6D56
 
+#include <algorithm>
+#include <array>
+#include <cstddef>
 #include <expected>
 #include <format>
 #include <iterator>
+#include <memory>
 #include <ranges>
 #include <string>
 #include <type_traits>
@@ -13,9 +17,12 @@
 #include <concepts>
 
 #include "yeti/core.hpp"
+#include "yeti/core/analysis.hpp"
+#include "yeti/core/arena.hpp"
 #include "yeti/core/flat_variant.hpp"
 #include "yeti/core/generics.hpp"
 #include "yeti/core/parser_fn.hpp"
+#include "yeti/generic/segmented.hpp"
 #include "yeti/generic/trivial.hpp"
 
 namespace yeti {
@@ -62,14 +69,21 @@ template <typename Self, typename R>
 concept expected_invocable =
     expected_invocable_help<forward_fn_t<Self>, std::ranges::iterator_t<R>>;
 
-/* F must be copy constructible such that we can satisfy parser_fn */
-template <std::copy_constructible F>
+/* F must be move constructible such that we can satisfy parser_fn */
+template <std::move_constructible F>
 struct satisfy final {
 
   static_assert(std::same_as<F, strip<F>>);
 
+  static constexpr grammar_info grammar = {tri::no, 1};
+
   [[no_unique_address]] F fn;
 
+  /**
+   * @brief The predicate's first set if it has one, otherwise everything.
+   */
+  [[nodiscard]] constexpr auto first() const -> first_set { return first_of(fn); }
+
   // TODO: Make specializations for skip and drop
 
   template <typename Self, typename S>
@@ -127,7 +141,7 @@ struct satisfy final {
  * @brief Build a parser from a function that matches a single token.
  */
 inline constexpr auto satisfy = []<typename F>(F &&fn) static
-  requires storable<F> && std::copy_constructible<strip<F>>
+  requires storable<F>
 {
   return combinate(lift(impl::any_impl::satisfy<strip<F>>{YETI_FWD(fn)}));
 };
@@ -157,6 +171,14 @@ struct lit {
 
   [[no_unique_address]] T tok;
 
+  [[nodiscard]] constexpr auto first() const -> first_set {
+    if constexpr (std::integral<T> && sizeof(T) == 1) {
+      return first_set::of(static_cast<unsigned char>(tok));
+    } else {
+      return first_set::any();
+    }
+  }
+
   template <std::equality_comparable_with<T> U>
   [[nodiscard]] constexpr auto
   operator()(this auto &&self, U &&val) -> std::expected<unit, err<T>> {
@@ -175,6 +197,362 @@ inline constexpr auto lit = []<typename T>(T &&tok) static
   return satisfy(impl::lit_impl::lit<strip<T>>{YETI_FWD(tok)});
 };
 
+// ===  === //
+// ===  === //
+// ===  === //
+
+namespace impl::lit_impl {
+
+template <typename T>
+concept byte_token = std::integral<T> && sizeof(T) == 1 && different_from<T, bool>;
+
+/**
+ * @brief True if `val` equals one of the tokens of type `T` in `set`.
+ */
+template <byte_token T, typename U>
+[[nodiscard]] constexpr auto member(first_set const &set, U const &val) -> bool {
+  if constexpr (std::integral<U>) {
+    T tok = static_cast<T>(val);
+    return tok == val && set.contains(static_cast<unsigned char>(tok));
+  } else {
+    for (int i = 0; i < 256; ++i) {
+      if (set.contains(static_cast<unsigned char>(i)) && val == static_cast<T>(i)) {
+        return true;
+      }
+    }
+    return false;
+  }
+}
+
+struct class_err {
+
+  first_set set;
+
+  [[nodiscard]] constexpr auto what() const -> std::string {
+
+    std::string out = "Expected one of [";
+
+    for (int i = 0; i < 256; ++i) {
+      if (set.contains(static_cast<unsigned char>(i))) {
+        out += static_cast<char>(i);
+      }
+    }
+
+    return out + "]";
+  }
+};
+
+/**
+ * @brief A token class, what an `alt` of single token literals fuses into.
+ */
+template <byte_token T>
+struct one_of {
+
+  first_set set;
+
+  [[nodiscard]] constexpr auto first() const -> first_set { return set; }
+
+  template <std::equality_comparable_with<T> U>
+  [[nodiscard]] constexpr auto
+  operator()(U const &val) const -> std::expected<unit, class_err> {
+    if (member<T>(set, val)) {
+      return {};
+    }
+    return std::expected<unit, class_err>{std::unexpect, set};
+  }
+};
+
+// Contiguous streams of `T` itself are compared/scanned as memory.
+template <typename S, typename T>
+concept bulk = std::ranges::contiguous_range<S> && std::ranges::sized_range<S> &&
+               std::same_as<std::ranges::range_value_t<S>, T> && std::integral<T>;
+
+/**
+ * @brief A run of skipped literals, what a `then` of literals fuses into.
+ *
+ * This behaves exactly like the sequence, including the unparsed input and
+ * error on a mismatch, but is a single compare on contiguous input.
+ */
+template <typename T, std::size_t N, bool Mute>
+struct chain {
+
+  static constexpr grammar_info grammar = {tri::no, N};
+
+  std::array<T, N> toks;
+
+  [[nodiscard]] constexpr auto first() const -> first_set {
+    if constexpr (byte_token<T>) {
+      return first_set::of(static_cast<unsigned char>(toks[0]));
+    } else {
+      return first_set::any();
+    }
+  }
+
+  [[nodiscard]] constexpr auto skip() const -> chain { return *this; }
+
+  [[nodiscard]] constexpr auto mute() const -> chain<T, N, true> { return {toks}; }
+
+  template <typename S>
+    requires recombinant_input_range<S> &&
+             std::equality_comparable_with<std::ranges::range_value_t<S>, T>
+  [[nodiscard]] constexpr auto
+  operator()(S &&stream) const -> specialization_of<result> auto {
+
+    using Err = std::conditional_t<Mute, unit, flat_variant<any_impl::eos, err<T>>>;
+    using Res = resulting_t<S, unit, Err>;
+    using Exp = Res::expected_type;
+
+    auto beg = std::ranges::begin(stream);
+    auto end = std::ranges::end(stream);
+
+    if constexpr (bulk<S, T>) {
+      if (std::ranges::size(stream) >= N &&
+          std::equal(toks.begin(), toks.end(), std::to_address(beg))) {
+        return Res{{std::next(std::move(beg), N), std::move(end)}, {}};
+      }
+    } else if constexpr (segmented_range<S>) {
+
+      auto seg = stream.segment();
+
+      if (std::ranges::size(seg) >= N &&
+          std::equal(toks.begin(), toks.end(), std::ranges::begin(seg))) {
+        return Res{stream.drop(N), {}};
+      }
+    }
+
+    // Also locates the mismatch after a failed bulk compare.
+    for (std::size_t i = 0; i < N; ++i, ++beg) {
+
+      bool at_end = beg == end;
+
+      if (!at_end && *beg == toks[i]) {
+        continue;
+      }
+
+      if constexpr (Mute) {
+        return Res{{std::move(beg), std::move(end)}, Exp{std::unexpect}};
+      } else if (at_end) {
+        return Res{{std::move(beg), std::move(end)}, Exp{std::unexpect, any_impl::eos{}}};
+      } else {
+        return Res{{std::move(beg), std::move(end)}, Exp{std::unexpect, err<T>{toks[i]}}};
+      }
+    }
+
+    return Res{{std::move(beg), std::move(end)}, {}};
+  }
+};
+
+/**
+ * @brief A bulk scan of a token class, what a `many` of a class fuses into.
+ */
+template <byte_token T, bool Skip>
+struct span {
+
+  static constexpr grammar_info grammar = {tri::yes, grammar_info::unbounded};
+
+  first_set set;
+
+  [[nodiscard]] constexpr auto first() const -> first_set { return set; }
+
+  [[nodiscard]] constexpr auto skip() const -> span<T, true> { return {set}; }
+
+  [[nodiscard]] constexpr auto mute() const -> span { return *this; }
+
+  template <typename S>
+    requires recombinant_input_range<S> &&
+             std::equality_comparable_with<std::ranges::range_value_t<S>, T>
+  [[nodiscard]] constexpr auto
+  operator()(S &&stream) const -> specialization_of<result> auto {
+
+    using V = std::ranges::range_value_t<S>;
+    using Val = std::conditional_t<Skip, unit, vector<V>>;
+    using Res = resulting_t<S, Val, never>;
+    using Exp = Res::expected_type;
+
+    auto beg = std::ranges::begin(stream);
+    auto end = std::ranges::end(stream);
+
+    Val acc{};
+
+    if constexpr (bulk<S, T>) {
+
+      T const *head = std::to_address(beg);
+      T const *tail = head + std::ranges::size(stream);
+      T const *cur = head;
+
+      while (cur != tail && set.contains(static_cast<unsigned char>(*cur))) {
+        ++cur;
+      }
+
+      if constexpr (!Skip) {
+        acc.assign(head, cur);
+      }
+
+      beg += cur - head;
+
+    } else if constexpr (segmented_range<S>) {
+
+      // Scan segment by segment, a run may continue into the next one.
+      strip<S> rest = stream;
+
+      for (;;) {
+
+        auto seg = rest.segment();
+
+        auto stop = std::ranges::find_if_not(seg, [this](auto tok) {
+          return set.contains(static_cast<unsigned char>(tok));
+        });
+
+        if constexpr (!Skip) {
+          acc.insert(acc.end(), std::ranges::begin(seg), stop);
+        }
+
+        auto n = static_cast<std::size_t>(stop - std::ranges::begin(seg));
+
+        rest = rest.drop(n);
+
+        if (n < std::ranges::size(seg) || n == 0) {
+          break;
+        }
+      }
+
+      return Res{std::move(rest), Exp{std::in_place, std::move(acc)}};
+
+    } else {
+      for (; beg != end; ++beg) {
+
+        V tok = *beg;
+
+        if (!member<T>(set, tok)) {
+          break;
+        }
+
+        if constexpr (!Skip) {
+          acc.push_back(std::move(tok));
+        }
+      }
+    }
+
+    return Res{{std::move(beg), std::move(end)}, Exp{std::in_place, std::move(acc)}};
+  }
+};
+
+template <typename F, bool Skip, bool Mute>
+using lifted_t = parser_lift::lifted<any_impl::satisfy<F>, Skip, Mute>;
+
+// Skipped literals and runs of them, adjacent runs in a `then` fuse.
+template <typename P>
+struct run {};
+
+template <typename T, bool Mute>
+struct run<lifted_t<lit<T>, true, Mute>> {
+  using token = T;
+  static constexpr bool mute = Mute;
+  static constexpr auto tokens(auto const &p) -> std::array<T, 1> {
+    return {p.fn.fn.tok};
+  }
+};
+
+template <typename T, std::size_t N, bool Mute>
+struct run<chain<T, N, Mute>> {
+  using token = T;
+  static constexpr bool mute = Mute;
+  static constexpr auto tokens(auto const &p) -> std::array<T, N> { return p.toks; }
+};
+
+template <typename P, typename Q>
+concept runs = requires {
+  typename run<P>::token;
+  typename run<Q>::token;
+} && std::same_as<typename run<P>::token, typename run<Q>::token> &&
+                  run<P>::mute == run<Q>::mute;
+
+// Byte literals and classes, adjacent classes in an `alt` fuse.
+template <typename P>
+struct token_class {};
+
+template <byte_token T, bool Skip, bool Mute>
+struct token_class<lifted_t<lit<T>, Skip, Mute>> {
+  using token = T;
+  static constexpr bool skip = Skip;
+  static constexpr bool mute = Mute;
+  static constexpr auto set(auto const &p) -> first_set { return p.first(); }
+};
+
+template <byte_token T, bool Skip, bool Mute>
+struct token_class<lifted_t<one_of<T>, Skip, Mute>> {
+  using token = T;
+  static constexpr bool skip = Skip;
+  static constexpr bool mute = Mute;
+  static constexpr auto set(auto const &p) -> first_set { return p.first(); }
+};
+
+template <typename P, typename Q>
+concept classes = requires {
+  typename token_class<P>::token;
+  typename token_class<Q>::token;
+} && std::same_as<typename token_class<P>::token, typename token_class<Q>::token> &&
+                  token_class<P>::skip == token_class<Q>::skip &&
+                  token_class<P>::mute == token_class<Q>::mute;
+
+template <typename T, std::size_t N, std::size_t K>
+[[nodiscard]] constexpr auto
+concat(std::array<T, N> const &lhs, std::array<T, K> const &rhs) -> std::array<T, N + K> {
+  return [&]<std::size_t... I, std::size_t... J>(std::index_sequence<I...>,
+                                                 std::index_sequence<J...>) {
+    return std::array<T, N + K>{lhs[I]..., rhs[J]...};
+  }(std::make_index_sequence<N>{}, std::make_index_sequence<K>{});
+}
+
+} // namespace impl::lit_impl
+
+namespace impl::simplify_impl {
+
+template <typename P, typename Q>
+  requires lit_impl::runs<P, Q>
+struct fuse_then<P, Q> {
+  static constexpr auto fuse(P const &lhs, Q const &rhs) {
+
+    using T = lit_impl::run<P>::token;
+
+    auto toks = lit_impl::concat(lit_impl::run<P>::tokens(lhs), //
+                                 lit_impl::run<Q>::tokens(rhs));
+
+    constexpr std::size_t N = std::tuple_size_v<decltype(toks)>;
+
+    return lit_impl::chain<T, N, lit_impl::run<P>::mute>{toks};
+  }
+};
+
+template <typename P, typename Q>
+  requires lit_impl::classes<P, Q>
+struct fuse_alt<P, Q> {
+  static constexpr auto fuse(P const &lhs, Q const &rhs) {
+
+    using C = lit_impl::token_class<P>;
+    using T = C::token;
+
+    first_set set = C::set(lhs) | lit_impl::token_class<Q>::set(rhs);
+
+    using One = lit_impl::one_of<T>;
+
+    return lit_impl::lifted_t<One, C::skip, C::mute>{{any_impl::satisfy<One>{One{set}}}};
+  }
+};
+
+template <typename P>
+  requires requires { typename lit_impl::token_class<P>::token; }
+struct fuse_many<P> {
+  static constexpr auto fuse(P const &parser) {
+
+    using C = lit_impl::token_class<P>;
+
+    return lit_impl::span<typename C::token, C::skip>{C::set(parser)};
+  }
+};
+
+} // namespace impl::simplify_impl
+
 } // namespace yeti
 
 #endif /* BCC882F7_ED8D_4A23_B468_977755EA6D56 */
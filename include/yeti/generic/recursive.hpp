@@ -0,0 +1,345 @@
+#ifndef D43674C4_D486_4350_8F0A_E5600C499C40
+#define D43674C4_D486_4350_8F0A_E5600C499C40
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <expected>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+/**
+ * @brief Non-zero if deep recursion may continue on heap allocated stacks.
+ *
+ * Stacks are switched with `<ucontext.h>` (POSIX, deprecated on macOS).
+ * Elsewhere, or if defined to 0, a deep grammar fails with `too_deep` once
+ * its native stack budget is used.
+ */
+#ifndef YETI_STACK_SEGMENTS
+#if __has_include(<ucontext.h>) && !defined(__APPLE__)
+#define YETI_STACK_SEGMENTS 1
+#else
+#define YETI_STACK_SEGMENTS 0
+#endif
+#endif
+
+#if YETI_STACK_SEGMENTS
+#include <ucontext.h>
+#endif
+
+#include "yeti/core.hpp"
+#include "yeti/core/combinate/cut.hpp"
+#include "yeti/core/flat_variant.hpp"
+#include "yeti/core/generics.hpp"
+
+/**
+ * @brief Grammars that refer to themselves.
+ */
+
+namespace yeti {
+
+/**
+ * @brief Limits for a `recursive` grammar that may parse deeply nested input.
+ */
+struct depth_options {
+  std::size_t max_depth = 100'000;   ///< Deeper nesting fails with `too_deep`.
+  std::size_t native = 256 * 1024;   ///< Bytes of the thread's own stack to use.
+  std::size_t segment = 1024 * 1024; ///< Bytes per heap allocated stack segment.
+};
+
+/**
+ * @brief The nesting exceeded `depth_options::max_depth`.
+ */
+struct too_deep {
+  static constexpr auto what() noexcept -> std::string_view {
+    return "Nesting exceeds the depth limit";
+  }
+};
+
+namespace impl::recursive_impl {
+
+// Invoke the body, stored type-erased, and convert to the declared result.
+template <typename S, typename T, typename E, typename B>
+auto call(void const *body, S stream) -> result<S, T, E> {
+
+  auto const &fn = **static_cast<std::optional<B> const *>(body);
+
+  auto [rest, res] = std::invoke(fn, std::move(stream));
+
+  using Exp = std::expected<T, E>;
+
+  if (res) {
+    return {std::move(rest), Exp{std::in_place, flat_cast<T>(std::move(res).value())}};
+  }
+
+  return {std::move(rest), Exp{std::unexpect, flat_cast<E>(std::move(res).error())}};
+}
+
+// ===  === //
+// ===  === //
+// ===  === //
+
+// The stack the current thread is running on, shared by all deep grammars.
+struct stack_state {
+  std::size_t depth = 0;
+  std::uintptr_t base = 0;  ///< The top of the current stack (segment).
+  std::size_t budget = 0;   ///< Bytes usable below `base`.
+};
+
+inline thread_local stack_state stack;
+
+#if YETI_STACK_SEGMENTS
+
+struct job {
+  void (*fn)(void *);
+  void *arg;
+  std::exception_ptr err;
+};
+
+inline thread_local job *current_job = nullptr;
+
+inline void trampoline() {
+
+  job *task = current_job;
+
+  try {
+    task->fn(task->arg);
+  } catch (...) {
+    task->err = std::current_exception();
+  }
+}
+
+// Run `fn(arg)` on a fresh heap allocated stack of `size` bytes.
+inline void on_segment(std::size_t size, void (*fn)(void *), void *arg) {
+
+  constexpr std::size_t red_zone = 64 * 1024;
+
+  size = std::max(size, 4 * red_zone);
+
+  auto mem = std::make_unique_for_overwrite<char[]>(size); // Not zeroed.
+
+  job task{fn, arg, nullptr};
+
+  ucontext_t caller{};
+  ucontext_t callee{};
+
+  if (::getcontext(&callee) != 0) {
+    throw std::system_error(errno, std::system_category(), "getcontext");
+  }
+
+  callee.uc_stack.ss_sp = mem.get();
+  callee.uc_stack.ss_size = size;
+  callee.uc_link = &caller;
+
+  ::makecontext(&callee, &trampoline, 0);
+
+  stack_state saved = stack;
+
+  stack.base = reinterpret_cast<std::uintptr_t>(mem.get() + size);
+  stack.budget = size - red_zone;
+
+  current_job = &task;
+
+  int rc = ::swapcontext(&caller, &callee);
+
+  stack.base = saved.base;
+  stack.budget = saved.budget;
+
+  if (rc != 0) {
+    throw std::system_error(errno, std::system_category(), "swapcontext");
+  }
+
+  if (task.err) {
+    std::rethrow_exception(task.err);
+  }
+}
+
+#endif
+
+template <typename B>
+struct deep_body {
+  std::optional<B> body;
+  depth_options opt;
+};
+
+// As `call` but bounded in depth and moving to a new stack segment when the
+// current one is exhausted, the common case is a counter and a comparison.
+template <typename S, typename T, typename E, typename B>
+auto call_deep(void const *state, S stream) -> result<S, T, E> {
+
+  auto const &deep = *static_cast<deep_body<B> const *>(state);
+
+  auto fail = [&] -> result<S, T, E> {
+    using Exp = std::expected<T, E>;
+    return {
+        std::move(stream),
+        Exp{std::unexpect, flat_cast<E>(cut_impl::hard<too_deep>{})},
+    };
+  };
+
+  if (stack.depth >= deep.opt.max_depth) {
+    return fail();
+  }
+
+  char here = 0;
+
+  auto addr = reinterpret_cast<std::uintptr_t>(&here);
+
+  if (stack.depth == 0) {
+    stack.base = addr;
+    stack.budget = deep.opt.native;
+  }
+
+  struct scope {
+    scope() noexcept { ++stack.depth; }
+    scope(scope const &) = delete;
+    auto operator=(scope const &) -> scope & = delete;
+    ~scope() { --stack.depth; }
+  } guard;
+
+  if (stack.base < addr || stack.base - addr < stack.budget) {
+    return call<S, T, E, B>(&deep.body, std::move(stream));
+  }
+
+#if YETI_STACK_SEGMENTS
+
+  std::optional<result<S, T, E>> out;
+
+  auto work = [&] {
+    out.emplace(call<S, T, E, B>(&deep.body, std::move(stream)));
+  };
+
+  auto run = [](void *ptr) static {
+    (*static_cast<decltype(work) *>(ptr))();
+  };
+
+  on_segment(deep.opt.segment, run, &work);
+
+  return std::move(*out);
+
+#else
+
+  return fail();
+
+#endif
+}
+
+// ===  === //
+// ===  === //
+// ===  === //
+
+/**
+ * @brief The placeholder for the grammar within its own definition.
+ */
+template <typename S, typename T, typename E>
+struct handle {
+
+  using type = S;
+
+  auto (*fn)(void const *, S) -> result<S, T, E> = nullptr;
+  void const *body = nullptr;
+
+  [[nodiscard]] auto operator()(S stream) const -> result<S, T, E> {
+    return fn(body, std::move(stream));
+  }
+};
+
+template <typename S, typename T, typename E, typename F>
+using body_t =
+    strip<std::invoke_result_t<F, decltype(combinate(lift(handle<S, T, E>{})))>>;
+
+/**
+ * @brief Owns the body, copies share it.
+ */
+template <typename S, typename T, typename E, typename State, auto Call>
+struct recursive {
+
+  using type = S;
+
+  std::shared_ptr<State const> state;
+
+  [[nodiscard]] auto operator()(S stream) const -> result<S, T, E> {
+    return Call(state.get(), std::move(stream));
+  }
+};
+
+} // namespace impl::recursive_impl
+
+/**
+ * @brief Build a parser whose definition refers to itself.
+ *
+ * `define` is invoked once with a combinator standing in for the parser
+ * being defined and returns its body. The value and error types must be
+ * declared up-front (the body's are converted with `flat_cast`) and the
+ * stream type is fixed to `S`, e.g. balanced parentheses:
+ *
+ * @code
+ * auto parens = recursive<std::string_view, unit>([](auto self) {
+ *   return lit('(').then(self).then(lit(')')).then(self).drop().alt(pure);
+ * });
+ * @endcode
+ *
+ * A left-recursive definition recurses forever. Every level of nesting
+ * costs one indirect call, backtracking may re-parse nested input many
+ * times, see `memo`.
+ *
+ * Each level of nesting uses the native stack, see the `depth_options`
+ * overload for untrusted input.
+ */
+template <typename S, typename T, error E = unit, typename F>
+[[nodiscard]] auto recursive(F &&define) {
+
+  namespace rec = impl::recursive_impl;
+
+  using B = rec::body_t<S, T, E, F>;
+
+  auto state = std::make_shared<std::optional<B>>();
+
+  rec::handle<S, T, E> self{&rec::call<S, T, E, B>, state.get()};
+
+  state->emplace(std::invoke(YETI_FWD(define), combinate(lift(self))));
+
+  return combinate(lift(rec::recursive<S, T, E, std::optional<B>, &rec::call<S, T, E, B>>{
+      std::move(state),
+  }));
+}
+
+/**
+ * @brief As `recursive(define)` but safe on arbitrarily nested input.
+ *
+ * Nesting beyond `opt.max_depth` fails with a hard (see `cut`) `too_deep`
+ * error, the declared error type is widened to include it. Once a parse
+ * has used `opt.native` bytes of the thread's stack the recursion continues
+ * on heap allocated segments, hence the depth is limited by memory rather
+ * than by the size of the stack. Without `YETI_STACK_SEGMENTS` it fails
+ * with `too_deep` at that point instead, it never overflows either way.
+ */
+template <typename S, typename T, error E = unit, typename F>
+[[nodiscard]] auto recursive(F &&define, depth_options opt) {
+
+  namespace rec = impl::recursive_impl;
+
+  using Er = flat_union<E, impl::cut_impl::hard<too_deep>>;
+  using B = rec::body_t<S, T, Er, F>;
+
+  auto state = std::make_shared<rec::deep_body<B>>(std::nullopt, opt);
+
+  rec::handle<S, T, Er> self{&rec::call_deep<S, T, Er, B>, state.get()};
+
+  state->body.emplace(std::invoke(YETI_FWD(define), combinate(lift(self))));
+
+  using R = rec::recursive<S, T, Er, rec::deep_body<B>, &rec::call_deep<S, T, Er, B>>;
+
+  return combinate(lift(R{std::move(state)}));
+}
+
+} // namespace yeti
+
+#endif /* D43674C4_D486_4350_8F0A_E5600C499C40 */
@@ -0,0 +1,64 @@
+#ifndef A4C23F41_BA97_47E9_B028_1C55016A93BC
+#define A4C23F41_BA97_47E9_B028_1C55016A93BC
+
+#include <functional>
+#include <memory>
+#include <utility>
+
+#include "yeti/core.hpp"
+#include "yeti/core/analysis.hpp"
+#include "yeti/core/generics.hpp"
+
+/**
+ * @brief Composing parsers by reference.
+ */
+
+namespace yeti {
+
+namespace impl::ref_impl {
+
+template <parser P>
+struct ref {
+
+  static_assert(std::same_as<P, strip<P>>);
+
+  using type = type_of<P>;
+
+  static constexpr grammar_info grammar = grammar_of<P>;
+
+  P const *fn;
+
+  [[nodiscard]] constexpr auto first() const -> first_set { return first_of(*fn); }
+
+  template <typename S = type>
+    requires parser<P, S>
+  [[nodiscard]] constexpr auto operator()(S &&stream) const
+      YETI_HOF(std::invoke(*fn, YETI_FWD(stream)))
+};
+
+} // namespace impl::ref_impl
+
+/**
+ * @brief A parser that invokes `parser` through a pointer.
+ *
+ * Copying the result is O(1) whatever `parser` owns (tries, DFAs, lookup
+ * tables) and it is copyable even if `parser` is move-only. `parser` must
+ * outlive every parser built from the reference. The referee is opaque to
+ * tree simplification and fusion, `skip`/`mute` discard its value/error.
+ */
+template <typename P>
+  requires parser<strip<P>>
+[[nodiscard]] constexpr auto ref(P const &parser) {
+  return combinate(lift(impl::ref_impl::ref<strip<P>>{std::addressof(parser)}));
+}
+
+/**
+ * @brief A reference to a temporary would dangle.
+ */
+template <typename P>
+  requires parser<strip<P>>
+auto ref(P const &&parser) = delete;
+
+} // namespace yeti
+
+#endif /* A4C23F41_BA97_47E9_B028_1C55016A93BC */
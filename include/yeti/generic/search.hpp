@@ -0,0 +1,552 @@
+#ifndef DE58A2F9_AC6C_4D79_B92B_B124A026C39E
+#define DE58A2F9_AC6C_4D79_B92B_B124A026C39E
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <optional>
+#include <ranges>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "yeti/core.hpp"
+#include "yeti/core/analysis.hpp"
+#include "yeti/core/combinate/cut.hpp"
+#include "yeti/core/combinate/fixed.hpp"
+#include "yeti/core/flat_variant.hpp"
+#include "yeti/core/generics.hpp"
+#include "yeti/generic/keys.hpp"
+
+/**
+ * @brief Unanchored search for many literals with an Aho-Corasick automaton.
+ */
+
+namespace yeti {
+
+/**
+ * @brief No (accepted) match before the end of the stream.
+ */
+struct not_found {
+  static constexpr auto what() noexcept -> std::string_view {
+    return "No match before the end of the input";
+  }
+};
+
+namespace impl::search_impl {
+
+// ===  === //
+// ===  === //
+// ===  === //
+
+/**
+ * @brief A dense Aho-Corasick automaton over byte classes.
+ *
+ * The bytes of the patterns each get a class, all other bytes share class
+ * 0. Failure links are folded into `next` so a step is one load, the
+ * patterns ending at a state are found by following `match` then `link`,
+ * longest first. No match can start more than `depth` bytes before the
+ * position of a state.
+ */
+struct machine {
+  std::array<std::uint16_t, 256> cls{};
+  std::size_t classes = 1;
+  std::vector<std::int32_t> next;  // [state * classes + class]
+  std::vector<std::int32_t> out;   // The pattern spelled by this state or -1.
+  std::vector<std::int32_t> match; // The first suffix state with an `out`.
+  std::vector<std::int32_t> link;  // The next such state after this one.
+  std::vector<std::size_t> length; // The length of each pattern.
+  std::vector<std::size_t> depth;  // The length of the prefix spelled by a state.
+  first_set first;
+};
+
+[[nodiscard]] constexpr auto build(std::vector<std::string_view> const &pats) -> machine {
+
+  machine m;
+
+  for (std::string_view pat : pats) {
+
+    if (pat.empty()) {
+      throw std::invalid_argument("search: empty pattern");
+    }
+
+    m.first = m.first | first_set::of(static_cast<unsigned char>(pat.front()));
+
+    for (char c : pat) {
+      m.cls[static_cast<unsigned char>(c)] = 1;
+    }
+  }
+
+  for (std::uint16_t &c : m.cls) {
+    if (c != 0) {
+      c = static_cast<std::uint16_t>(m.classes++);
+    }
+  }
+
+  std::size_t const k = m.classes;
+
+  // The trie, -1 where there is no edge.
+  std::vector<std::int32_t> go(k, -1);
+
+  m.out = {-1};
+  m.depth = {0};
+
+  for (std::size_t i = 0; i < pats.size(); ++i) {
+
+    std::size_t s = 0;
+
+    for (char c : pats[i]) {
+
+      std::size_t e = s * k + m.cls[static_cast<unsigned char>(c)];
+
+      if (go[e] < 0) {
+        go[e] = static_cast<std::int32_t>(m.out.size());
+        go.resize(go.size() + k, -1);
+        m.out.push_back(-1);
+        m.depth.push_back(m.depth[s] + 1);
+      }
+
+      s = static_cast<std::size_t>(go[e]);
+    }
+
+    if (m.out[s] >= 0) {
+      throw std::invalid_argument("search: duplicate pattern");
+    }
+
+    m.out[s] = static_cast<std::int32_t>(i);
+    m.length.push_back(pats[i].size());
+  }
+
+  std::size_t const states = m.out.size();
+
+  std::vector<std::size_t> fail(states, 0);
+
+  m.next.assign(states * k, 0);
+  m.match.assign(states, -1);
+  m.link.assign(states, -1);
+
+  // Breadth first, the failure target of a state is always shallower.
+  std::vector<std::size_t> queue = {0};
+
+  for (std::size_t q = 0; q < queue.size(); ++q) {
+
+    std::size_t s = queue[q];
+
+    if (s != 0) {
+      m.link[s] = m.match[fail[s]];
+      m.match[s] = m.out[s] >= 0 ? static_cast<std::int32_t>(s) : m.link[s];
+    }
+
+    for (std::size_t c = 0; c < k; ++c) {
+
+      std::int32_t via = s == 0 ? 0 : m.next[fail[s] * k + c];
+
+      if (std::int32_t t = go[s * k + c]; t >= 0) {
+        fail[static_cast<std::size_t>(t)] = static_cast<std::size_t>(via);
+        queue.push_back(static_cast<std::size_t>(t));
+        m.next[s * k + c] = t;
+      } else {
+        m.next[s * k + c] = via;
+      }
+    }
+  }
+
+  return m;
+}
+
+/**
+ * @brief A `machine` frozen into arrays for use at compile time.
+ */
+template <std::size_t States, std::size_t Classes, std::size_t N>
+struct table {
+  std::array<std::uint16_t, 256> cls{};
+  std::size_t classes = Classes;
+  std::array<std::int32_t, States * Classes> next{};
+  std::array<std::int32_t, States> out{};
+  std::array<std::int32_t, States> match{};
+  std::array<std::int32_t, States> link{};
+  std::array<std::size_t, N> length{};
+  std::array<std::size_t, States> depth{};
+  first_set first;
+};
+
+template <std::size_t States, std::size_t Classes, std::size_t N>
+[[nodiscard]] constexpr auto freeze(machine const &m) -> table<States, Classes, N> {
+
+  table<States, Classes, N> out;
+
+  out.cls = m.cls;
+  out.first = m.first;
+
+  std::ranges::copy(m.next, out.next.begin());
+  std::ranges::copy(m.out, out.out.begin());
+  std::ranges::copy(m.match, out.match.begin());
+  std::ranges::copy(m.link, out.link.begin());
+  std::ranges::copy(m.length, out.length.begin());
+  std::ranges::copy(m.depth, out.depth.begin());
+
+  return out;
+}
+
+template <fixed_value... Pat>
+[[nodiscard]] constexpr auto compile() -> machine {
+  return build({std::string_view{Pat.data, std::size(Pat.data) - 1}...});
+}
+
+template <fixed_value... Pat>
+inline constexpr auto shape = [] {
+  machine m = compile<Pat...>();
+  return std::pair{m.out.size(), m.classes};
+}();
+
+template <fixed_value... Pat>
+inline constexpr auto compiled =
+    freeze<shape<Pat...>.first, shape<Pat...>.second, sizeof...(Pat)>(compile<Pat...>());
+
+} // namespace impl::search_impl
+
+/**
+ * @brief A set of patterns compiled at runtime for `find_any` and `scan`.
+ *
+ * Move-only, parsers refer to it so it must outlive them.
+ */
+class aho_corasick {
+ public:
+  /**
+   * @brief Compile `pats`, throws `std::invalid_argument` on an empty or
+   * duplicate pattern. A match reports the index of its pattern in `pats`.
+   */
+  template <std::ranges::input_range R>
+    requires std::convertible_to<std::ranges::range_reference_t<R>, std::string_view>
+  explicit aho_corasick(R &&pats) {
+
+    impl::key_views views{YETI_FWD(pats)};
+
+    m_machine = impl::search_impl::build(views.get());
+  }
+
+  aho_corasick(aho_corasick const &) = delete;
+  aho_corasick(aho_corasick &&) noexcept = default;
+  auto operator=(aho_corasick const &) -> aho_corasick & = delete;
+  auto operator=(aho_corasick &&) noexcept -> aho_corasick & = default;
+  ~aho_corasick() = default;
+
+  /**
+   * @brief The number of states of the automaton.
+   */
+  [[nodiscard]] auto states() const noexcept -> std::size_t {
+    return m_machine.out.size();
+  }
+
+  [[nodiscard]] auto automaton() const noexcept -> impl::search_impl::machine const & {
+    return m_machine;
+  }
+
+ private:
+  impl::search_impl::machine m_machine;
+};
+
+namespace impl::search_impl {
+
+// ===  === //
+// ===  === //
+// ===  === //
+
+// The automaton of compile time patterns.
+template <fixed_value... Pat>
+struct fixed {
+  [[nodiscard]] static constexpr auto automaton() -> auto const & {
+    return compiled<Pat...>;
+  }
+};
+
+// The automaton of an `aho_corasick`.
+struct dynamic {
+
+  aho_corasick const *dict;
+
+  [[nodiscard]] auto automaton() const -> machine const & { return dict->automaton(); }
+};
+
+template <typename S>
+concept byte_stream = recombinant_forward_range<S> &&
+                      std::integral<std::ranges::range_value_t<S>> &&
+                      sizeof(std::ranges::range_value_t<S>) == 1;
+
+/**
+ * @brief Advance `it` through the automaton, calling `on_match(pattern, at,
+ * depth)` for each pattern ending before `it`, until one returns true.
+ *
+ * `at` is the number of bytes consumed and no later match starts before
+ * `at - depth`.
+ */
+template <typename A, typename I, typename E, typename F>
+[[nodiscard]] constexpr auto run(A const &a, I &it, E const &end, F &&on_match) -> bool {
+
+  auto byte = [](auto tok) static {
+    return static_cast<unsigned char>(tok);
+  };
+
+  std::size_t s = 0;
+  std::size_t at = 0;
+
+  while (it != end) {
+
+    // Noise, skip to the next byte that can start a pattern.
+    if (s == 0) {
+      while (it != end && !a.first.contains(byte(*it))) {
+        ++it;
+        ++at;
+      }
+      if (it == end) {
+        return false;
+      }
+    }
+
+    s = static_cast<std::size_t>(a.next[s * a.classes + a.cls[byte(*it)]]);
+
+    ++it;
+    ++at;
+
+    for (std::int32_t t = a.match[s]; t >= 0;) {
+
+      auto u = static_cast<std::size_t>(t);
+
+      if (std::invoke(on_match, a.out[u], at, a.depth[s])) {
+        return true;
+      }
+
+      t = a.link[u];
+    }
+  }
+
+  return false;
+}
+
+/**
+ * @brief Consume up to and including the first match of any pattern.
+ */
+template <typename H>
+struct finder {
+
+  static constexpr grammar_info grammar = {tri::no, grammar_info::unbounded};
+
+  [[no_unique_address]] H dict;
+
+  template <byte_stream S>
+  [[nodiscard]] constexpr auto
+  operator()(S &&stream) const -> resulting_t<S, std::size_t, not_found> {
+
+    using Exp = std::expected<std::size_t, not_found>;
+
+    auto it = std::ranges::begin(stream);
+    auto end = std::ranges::end(stream);
+
+    std::size_t idx = 0;
+
+    bool hit = run(dict.automaton(), it, end, [&idx](std::int32_t pat, auto...) {
+      idx = static_cast<std::size_t>(pat);
+      return true;
+    });
+
+    if (!hit) {
+      return {YETI_FWD(stream), Exp{std::unexpect}};
+    }
+
+    return {{std::move(it), std::move(end)}, Exp{idx}};
+  }
+};
+
+template <parser P, typename H>
+struct scanner;
+
+template <typename P, typename H>
+[[nodiscard]] constexpr auto make(P &&parser, H dict)
+    YETI_HOF(scanner<strip<P>, H>{YETI_FWD(parser), dict})
+
+/**
+ * @brief Try `fn` at the start of each match of a pattern, leftmost first.
+ */
+template <parser P, typename H>
+struct scanner {
+
+  static_assert(std::same_as<P, strip<P>>);
+
+  using type = type_of<P>;
+
+  static constexpr grammar_info grammar = {
+      grammar_of<P>.nullable && tri::maybe,
+      grammar_info::unbounded,
+  };
+
+  [[no_unique_address]] P fn;
+  [[no_unique_address]] H dict;
+
+  [[nodiscard]] constexpr auto skip(this auto &&self)
+      YETI_HOF(make(YETI_FWD(self).fn.skip(), self.dict))
+
+  [[nodiscard]] constexpr auto mute(this auto &&self)
+      YETI_HOF(make(YETI_FWD(self).fn.mute(), self.dict))
+
+  template <typename S = type>
+    requires parser<P, strip<S>> && byte_stream<strip<S>> &&
+             std::ranges::bidirectional_range<strip<S>>
+  [[nodiscard]] constexpr auto
+  operator()(this auto &&self, S &&stream) -> specialization_of<result> auto {
+
+    using E = parse_error_t<P, strip<S>>;
+
+    // Only the hard errors of `fn` end the scan, the others are retried.
+    using Er = std::conditional_t<std::same_as<E, unit>,
+                                  unit,
+                                  std::conditional_t<cut_impl::may_be_hard<E>,
+                                                     flat_union<not_found, E>,
+                                                     not_found>>;
+
+    using Res = resulting_t<S, parse_value_t<P, strip<S>>, Er>;
+    using Exp = Res::expected_type;
+
+    auto const &a = self.dict.automaton();
+
+    auto it = std::ranges::begin(stream);
+    auto end = std::ranges::end(stream);
+
+    using I = std::ranges::iterator_t<strip<S>>;
+
+    std::optional<Res> got;
+
+    auto attempt = [&](I from) -> bool {
+
+      auto [rest, res] = std::invoke(self.fn, strip<S>{std::move(from), end});
+
+      if (res) {
+        got.emplace(std::move(rest), Exp{std::in_place, std::move(res).value()});
+        return true;
+      }
+
+      if constexpr (cut_impl::may_be_hard<E>) {
+        if (cut_impl::is_hard(res.error())) {
+          got.emplace(std::move(rest),
+                      Exp{std::unexpect, flat_cast<Er>(std::move(res).error())});
+          return true;
+        }
+      }
+
+      return false;
+    };
+
+    // Matches are reported by their end, a trigger may end after one that
+    // starts later (e.g. "abcd" and "c"). Starts are held, in order, until
+    // no later match can start before them, each is tried once.
+    std::vector<std::pair<std::size_t, I>> pending;
+
+    std::size_t untried = 0;
+
+    auto flush = [&](std::size_t upto) -> bool {
+
+      auto stop = pending.begin();
+
+      for (; stop != pending.end() && stop->first <= upto; ++stop) {
+        if (stop->first >= untried) {
+
+          untried = stop->first + 1;
+
+          if (attempt(stop->second)) {
+            return true;
+          }
+        }
+      }
+
+      pending.erase(pending.begin(), stop);
+
+      return false;
+    };
+
+    auto on_match = [&](std::int32_t pat, std::size_t at, std::size_t depth) -> bool {
+
+      std::size_t len = a.length[static_cast<std::size_t>(pat)];
+
+      auto pos = std::ranges::upper_bound(pending, at - len, {}, [](auto const &p) {
+        return p.first;
+      });
+
+      auto from = std::ranges::prev(it, static_cast<std::ptrdiff_t>(len));
+
+      pending.emplace(pos, at - len, std::move(from));
+
+      return flush(at - depth);
+    };
+
+    if (run(a, it, end, on_match) || flush(std::numeric_limits<std::size_t>::max())) {
+      return std::move(*got);
+    }
+
+    if constexpr (std::same_as<Er, unit>) {
+      return Res{YETI_FWD(stream), Exp{std::unexpect}};
+    } else {
+      return Res{YETI_FWD(stream), Exp{std::unexpect, flat_cast<Er>(not_found{})}};
+    }
+  }
+};
+
+} // namespace impl::search_impl
+
+/**
+ * @brief Skip to and past the first occurrence of any of `Pat...`.
+ *
+ * The value is the index of the pattern, at a position where several end
+ * the longest wins. The patterns are compiled to an Aho-Corasick automaton
+ * at compile time, the search is one table step per byte (noise that
+ * cannot start a pattern is skipped with a bitset test). The stream must
+ * be a forward range of bytes.
+ */
+template <fixed_value... Pat>
+[[nodiscard]] constexpr auto find_any() {
+  return combinate(lift(impl::search_impl::finder<impl::search_impl::fixed<Pat...>>{}));
+}
+
+/**
+ * @brief As above, for patterns only known at runtime.
+ */
+[[nodiscard]] inline auto find_any(aho_corasick const &dict) {
+  return combinate(lift(impl::search_impl::finder<impl::search_impl::dynamic>{{&dict}}));
+}
+
+/**
+ * @brief Parse `parser` at the first occurrence of a trigger where it succeeds.
+ *
+ * The triggers `Pat...` are searched for as by `find_any`, at each match
+ * `parser` is tried anchored at its start, leftmost start first, e.g.
+ * `scan<"mul(">(mul)` finds the first well formed `mul(x,y)` in garbage. A
+ * failure resumes the search, one pass over the input in total, a hard
+ * failure (see `cut`) ends it. The stream must be a bidirectional range of
+ * bytes.
+ */
+template <fixed_value... Pat, typename P>
+  requires parser<strip<P>>
+[[nodiscard]] constexpr auto scan(P &&parser) {
+  return combinate(
+      impl::search_impl::make(YETI_FWD(parser), impl::search_impl::fixed<Pat...>{}));
+}
+
+/**
+ * @brief As above, for triggers only known at runtime.
+ */
+template <typename P>
+  requires parser<strip<P>>
+[[nodiscard]] auto scan(P &&parser, aho_corasick const &dict) {
+  return combinate(
+      impl::search_impl::make(YETI_FWD(parser), impl::search_impl::dynamic{&dict}));
+}
+
+} // namespace yeti
+
+#endif /* DE58A2F9_AC6C_4D79_B92B_B124A026C39E */
@@ -0,0 +1,155 @@
+#ifndef A2C7E5F3_9B14_4E0D_8F6A_5D3B1C9E7A42
+#define A2C7E5F3_9B14_4E0D_8F6A_5D3B1C9E7A42
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <ranges>
+#include <span>
+#include <type_traits>
+
+namespace yeti {
+
+/**
+ * @brief A rope: a list of contiguous segments presented as one stream.
+ *
+ * The segments are not copied, both they and the list of them must outlive
+ * the view. Iteration within a segment is a pointer increment, empty
+ * segments are skipped. Parsers that can exploit contiguity may use
+ * `segment()`/`drop()` to consume whole runs of the current segment, as
+ * fused literals and `pattern` do.
+ */
+template <typename T>
+class segmented {
+ public:
+  using segment_type = std::span<T const>;
+
+  class iterator {
+   public:
+    using value_type = T;
+    using difference_type = std::ptrdiff_t;
+
+    iterator() = default;
+
+    constexpr iterator(segment_type const *seg, segment_type const *last) noexcept
+        : m_seg{seg},
+          m_last{last} {
+      settle();
+    }
+
+    constexpr auto operator*() const noexcept -> T const & { return *m_cur; }
+
+    constexpr auto operator++() noexcept -> iterator & {
+      if (++m_cur == m_end) {
+        ++m_seg;
+        settle();
+      }
+      return *this;
+    }
+
+    constexpr auto operator++(int) noexcept -> iterator {
+      auto tmp = *this;
+      ++*this;
+      return tmp;
+    }
+
+    friend constexpr auto
+    operator==(iterator const &lhs, iterator const &rhs) noexcept -> bool {
+      return lhs.m_seg == rhs.m_seg && lhs.m_cur == rhs.m_cur;
+    }
+
+    friend constexpr auto
+    operator==(iterator const &it, std::default_sentinel_t) noexcept -> bool {
+      return it.m_seg == it.m_last;
+    }
+
+   private:
+    friend class segmented;
+
+    // Move to the first token at or after the start of `m_seg`.
+    constexpr void settle() noexcept {
+
+      while (m_seg != m_last && m_seg->empty()) {
+        ++m_seg;
+      }
+
+      if (m_seg == m_last) {
+        m_cur = m_end = nullptr;
+      } else {
+        m_cur = m_seg->data();
+        m_end = m_seg->data() + m_seg->size();
+      }
+    }
+
+    segment_type const *m_seg = nullptr;
+    segment_type const *m_last = nullptr;
+    T const *m_cur = nullptr;
+    T const *m_end = nullptr;
+  };
+
+  segmented() = default;
+
+  constexpr explicit segmented(std::span<segment_type const> segments) noexcept
+      : m_beg{segments.data(), segments.data() + segments.size()} {}
+
+  constexpr segmented(iterator beg, std::default_sentinel_t) noexcept : m_beg{beg} {}
+
+  [[nodiscard]] constexpr auto begin() const noexcept -> iterator { return m_beg; }
+
+  [[nodiscard]] static constexpr auto end() noexcept -> std::default_sentinel_t {
+    return {};
+  }
+
+  [[nodiscard]] constexpr auto empty() const noexcept -> bool {
+    return m_beg == std::default_sentinel;
+  }
+
+  /**
+   * @brief The unconsumed part of the current segment (empty at the end).
+   */
+  [[nodiscard]] constexpr auto segment() const noexcept -> segment_type {
+    return {m_beg.m_cur, m_beg.m_end};
+  }
+
+  /**
+   * @brief Skip `n` tokens, O(1) within a segment.
+   */
+  [[nodiscard]] constexpr auto drop(std::size_t n) const noexcept -> segmented {
+
+    iterator it = m_beg;
+
+    while (n > 0 && it != std::default_sentinel) {
+
+      auto step = std::min(n, static_cast<std::size_t>(it.m_end - it.m_cur));
+
+      n -= step;
+      it.m_cur += step;
+
+      if (it.m_cur == it.m_end) {
+        ++it.m_seg;
+        it.settle();
+      }
+    }
+
+    return {it, {}};
+  }
+
+ private:
+  iterator m_beg;
+};
+
+/**
+ * @brief A stream that exposes its current contiguous segment, e.g. `segmented`.
+ *
+ * Token scans and compares run over `segment()` and resume with `drop(n)`,
+ * they fall back to single tokens only across a segment boundary.
+ */
+template <typename S>
+concept segmented_range = std::ranges::forward_range<S> && requires (S const &s) {
+  { s.segment() } -> std::ranges::contiguous_range;
+  { s.drop(std::size_t{}) } -> std::same_as<std::remove_cvref_t<S>>;
+};
+
+} // namespace yeti
+
+#endif /* A2C7E5F3_9B14_4E0D_8F6A_5D3B1C9E7A42 */
@@ -0,0 +1,217 @@
+#ifndef A9E4D1F6_2C7B_4B83_9E15_6F0D3A8C2B71
+#define A9E4D1F6_2C7B_4B83_9E15_6F0D3A8C2B71
+
+#include <algorithm>
+#include <cstddef>
+#include <expected>
+#include <functional>
+#include <iterator>
+#include <optional>
+#include <ranges>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "yeti/core.hpp"
+#include "yeti/core/flat_variant.hpp"
+#include "yeti/core/generics.hpp"
+#include "yeti/core/parser_fn.hpp"
+#include "yeti/generic/locate.hpp"
+#include "yeti/generic/parse.hpp"
+#include "yeti/generic/range.hpp"
+
+namespace yeti {
+
+/**
+ * @brief Tuning knobs for `speculate`.
+ */
+struct speculate_options {
+  std::size_t threads = std::max(1U, std::thread::hardware_concurrency()); ///< Chunks.
+  std::size_t threshold = 1024 * 1024; ///< Shorter inputs are parsed serially.
+};
+
+namespace impl::speculate_impl {
+
+struct stalled {
+  [[nodiscard]] static constexpr auto what() noexcept -> std::string_view {
+    return "Record parser succeeded without consuming input";
+  }
+};
+
+/**
+ * @brief The records parsed starting from some (possibly wrong) offset.
+ */
+template <typename T, typename E>
+struct chunk {
+  std::vector<std::size_t> starts; ///< Offset of each record in `values`.
+  std::vector<T> values;           ///< The parsed records.
+  std::size_t end = 0;             ///< Where the last good record ended.
+  std::size_t at = 0;              ///< Where the failed parse stopped.
+  std::optional<E> error;          ///< Why parsing stopped (if not at a limit).
+};
+
+template <typename P, typename S>
+struct driver {
+
+  using T = parse_value_t<P, S>;
+  using E = flat_variant<parse_error_t<P, S>, stalled>;
+  using C = chunk<T, E>;
+
+  using result_type = std::expected<std::vector<T>, failure<S, E>>;
+
+  P const &record;
+  S const &input;
+
+  [[nodiscard]] constexpr auto from(std::size_t offset) const -> S {
+    auto beg = std::ranges::begin(input);
+    return S{std::ranges::next(beg, static_cast<std::ptrdiff_t>(offset)),
+             std::ranges::end(input)};
+  }
+
+  /**
+   * @brief Parse records from `pos` until one starts at or after `limit`.
+   */
+  [[nodiscard]] constexpr auto run(std::size_t pos, std::size_t limit) const -> C {
+
+    C out;
+
+    while (pos < limit) {
+
+      auto [rest, result] = std::invoke(record, from(pos));
+
+      std::size_t next = offset_of(input, rest);
+
+      if (!result) {
+        out.error = flat_cast<E>(std::move(result).error());
+        out.at = next;
+        break;
+      }
+
+      if (next == pos) {
+        out.error = E{stalled{}};
+        out.at = next;
+        break;
+      }
+
+      out.starts.push_back(pos);
+      out.values.push_back(std::move(result).value());
+
+      pos = next;
+    }
+
+    out.end = pos;
+
+    return out;
+  }
+
+  /**
+   * @brief Speculatively parse `[beg, limit)` from the first sync point.
+   */
+  [[nodiscard]] constexpr auto
+  guess(auto const &sync, std::size_t beg, std::size_t limit) const -> C {
+
+    while (beg < limit && !static_cast<bool>(std::invoke(sync, from(beg)))) {
+      ++beg;
+    }
+
+    return run(beg, limit);
+  }
+};
+
+} // namespace impl::speculate_impl
+
+/**
+ * @brief Parse a sequence of records from `input` using several threads.
+ *
+ * The input is cut at arbitrary offsets, each thread (bar the first) skips
+ * forward from its offset to the first position accepted by `sync` and
+ * parses records speculatively from there. Records carry no parser state
+ * across their boundaries, so a speculative chunk has synchronised with the
+ * true parse iff the true parse lands on one of the chunk's record offsets;
+ * its records from that point on are kept. Chunks which mis-speculated are
+ * discarded and re-parsed from the true position.
+ *
+ * @param record Parses one record, it must consume input on success.
+ * @param sync A predicate or parser, invoked with the stream at a candidate
+ *             offset, which accepts plausible record starts (a sync token).
+ * @param input A random-access, sized stream.
+ *
+ * The result is equivalent to applying `record` repeatedly until the input
+ * is exhausted, the first error is located in the whole input.
+ */
+template <typename P, typename Y, std::ranges::random_access_range S>
+  requires parser_fn<P, S> && std::ranges::sized_range<S> &&
+           recombinant_forward_range<S>
+[[nodiscard]] auto
+speculate(P const &record, Y const &sync, S const &input, speculate_options opt = {})
+    -> impl::speculate_impl::driver<P, S>::result_type {
+
+  using D = impl::speculate_impl::driver<P, S>;
+  using C = D::C;
+  using F = failure<S, typename D::E>;
+
+  D drv{record, input};
+
+  std::size_t size = std::ranges::size(input);
+
+  std::size_t n = size < opt.threshold ? 1 : std::max<std::size_t>(opt.threads, 1);
+
+  std::vector<std::size_t> cuts(n + 1);
+
+  for (std::size_t i = 0; i <= n; ++i) {
+    cuts[i] = i * size / n;
+  }
+
+  std::vector<C> chunks(n);
+
+  {
+    std::vector<std::jthread> pool;
+
+    pool.reserve(n - 1);
+
+    for (std::size_t i = 1; i < n; ++i) {
+      pool.emplace_back([&, i] {
+        chunks[i] = drv.guess(sync, cuts[i], cuts[i + 1]);
+      });
+    }
+
+    chunks[0] = drv.run(0, cuts[1]);
+  }
+
+  std::vector<parse_value_t<P, S>> out;
+
+  std::size_t pos = 0;
+
+  for (std::size_t i = 0; i < n; ++i) {
+
+    if (pos >= cuts[i + 1]) {
+      continue; // A record straddled this whole chunk.
+    }
+
+    C *c = &chunks[i];
+
+    auto hit = std::ranges::lower_bound(c->starts, pos);
+
+    if (pos != c->end && (hit == c->starts.end() || *hit != pos)) {
+      *c = drv.run(pos, cuts[i + 1]); // Mis-speculated, redo from the truth.
+      hit = c->starts.begin();
+    }
+
+    auto skip = std::ranges::distance(c->starts.begin(), hit);
+
+    std::ranges::move(c->values | std::views::drop(skip), std::back_inserter(out));
+
+    pos = c->end;
+
+    if (c->error) {
+      return std::unexpected(F{std::move(*c->error), input, c->at});
+    }
+  }
+
+  return out;
+}
+
+} // namespace yeti
+
+#endif /* A9E4D1F6_2C7B_4B83_9E15_6F0D3A8C2B71 */
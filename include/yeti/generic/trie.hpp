@@ -0,0 +1,399 @@
+#ifndef DF320628_790C_443D_A7D4_4EAC4E6B6760
+#define DF320628_790C_443D_A7D4_4EAC4E6B6760
+
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <iterator>
+#include <numeric>
+#include <ranges>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "yeti/core.hpp"
+#include "yeti/core/analysis.hpp"
+#include "yeti/core/generics.hpp"
+#include "yeti/generic/keys.hpp"
+
+/**
+ * @brief Longest match over a large, runtime built, set of keys.
+ */
+
+namespace yeti {
+
+namespace impl::trie_impl {
+
+/**
+ * @brief A double-array trie node, a transition on byte `c` from node `s`
+ * is to `t = cells[s].base + c` if `cells[t].check == s`.
+ */
+struct cell {
+  std::int32_t base = 0;
+  std::int32_t check = -1; // Parent, -1 if free.
+  std::int32_t value = -1; // Key index if a key ends here.
+};
+
+/**
+ * @brief Places the children of each node, breadth first, at free offsets.
+ */
+class builder {
+ public:
+  builder() { grow(257); }
+
+  [[nodiscard]] auto
+  build(std::vector<std::string_view> const &key) && -> std::vector<cell> {
+
+    std::vector<std::int32_t> idx(key.size());
+
+    std::iota(idx.begin(), idx.end(), 0);
+
+    // Byte-wise (unsigned) order, so children sharing a label are adjacent.
+    std::ranges::sort(idx, [&](std::int32_t a, std::int32_t b) {
+      return std::pair{key[a], a} < std::pair{key[b], b};
+    });
+
+    for (std::size_t i = 0; i < idx.size(); ++i) {
+      if (key[idx[i]].empty()) {
+        throw std::invalid_argument("trie: empty key");
+      }
+      if (i > 0 && key[idx[i]] == key[idx[i - 1]]) {
+        throw std::invalid_argument("trie: duplicate key");
+      }
+    }
+
+    unlist(0);
+    m_cells[0].check = 0; // The root, its own parent.
+
+    std::vector<pending> queue = {{0, 0, idx.size(), 0}};
+
+    std::vector<unsigned char> label;
+    std::vector<std::size_t> start;
+
+    for (std::size_t q = 0; q < queue.size(); ++q) {
+
+      auto [node, lo, hi, depth] = queue[q];
+
+      if (lo < hi && key[idx[lo]].size() == depth) {
+        m_cells[node].value = idx[lo++];
+      }
+
+      label.clear();
+      start.clear();
+
+      for (std::size_t i = lo; i < hi; ++i) {
+        auto c = static_cast<unsigned char>(key[idx[i]][depth]);
+        if (label.empty() || label.back() != c) {
+          label.push_back(c);
+          start.push_back(i);
+        }
+      }
+
+      if (label.empty()) {
+        continue;
+      }
+
+      start.push_back(hi);
+
+      std::int32_t base = place(label);
+
+      m_cells[node].base = base;
+
+      for (std::size_t j = 0; j < label.size(); ++j) {
+        std::int32_t t = base + label[j];
+        unlist(t);
+        m_cells[t].check = node;
+        queue.push_back({t, start[j], start[j + 1], depth + 1});
+      }
+    }
+
+    std::size_t n = m_cells.size();
+
+    while (m_cells[n - 1].check < 0) {
+      --n;
+    }
+
+    m_cells.resize(n);
+    m_cells.shrink_to_fit();
+
+    return std::move(m_cells);
+  }
+
+ private:
+  struct pending {
+    std::int32_t node;
+    std::size_t lo;
+    std::size_t hi;
+    std::size_t depth;
+  };
+
+  static constexpr std::uint8_t unlisted = 0xff;
+
+  // A free cell that fails this many times as a placement start is no
+  // longer tried, this keeps dense regions from being rescanned.
+  static constexpr std::uint8_t patience = 16;
+
+  // The smallest base whose cells for every label are free.
+  [[nodiscard]] auto place(std::vector<unsigned char> const &label) -> std::int32_t {
+
+    for (std::int32_t e = m_head;;) {
+
+      if (e < 0) {
+        e = static_cast<std::int32_t>(m_cells.size());
+        grow(m_cells.size() + 257);
+      }
+
+      std::int32_t base = e - label.front();
+      std::int32_t next = m_next[e];
+
+      if (base < 1) {
+        unlist(e);
+      } else {
+
+        bool ok = std::ranges::all_of(label, [&](unsigned char c) {
+          auto t = static_cast<std::size_t>(base + c);
+          return t >= m_cells.size() || m_cells[t].check < 0;
+        });
+
+        if (ok) {
+          grow(static_cast<std::size_t>(base + label.back()) + 1);
+          return base;
+        }
+
+        if (++m_fails[e] >= patience) {
+          unlist(e);
+        }
+      }
+
+      e = next;
+    }
+  }
+
+  // Append cells to the end of the array and of the free list.
+  void grow(std::size_t n) {
+
+    std::size_t old = m_cells.size();
+
+    if (n <= old) {
+      return;
+    }
+
+    n = std::max(n, 2 * old);
+
+    m_cells.resize(n);
+    m_next.resize(n);
+    m_prev.resize(n);
+    m_fails.resize(n);
+
+    for (std::size_t i = old; i < n; ++i) {
+      m_prev[i] = i == old ? m_tail : static_cast<std::int32_t>(i - 1);
+      m_next[i] = i + 1 == n ? -1 : static_cast<std::int32_t>(i + 1);
+    }
+
+    if (m_tail < 0) {
+      m_head = static_cast<std::int32_t>(old);
+    } else {
+      m_next[m_tail] = static_cast<std::int32_t>(old);
+    }
+
+    m_tail = static_cast<std::int32_t>(n - 1);
+  }
+
+  // Remove a (still free) cell from the free list.
+  void unlist(std::int32_t t) {
+
+    if (m_fails[t] == unlisted) {
+      return;
+    }
+
+    m_fails[t] = unlisted;
+
+    if (m_prev[t] < 0) {
+      m_head = m_next[t];
+    } else {
+      m_next[m_prev[t]] = m_next[t];
+    }
+
+    if (m_next[t] < 0) {
+      m_tail = m_prev[t];
+    } else {
+      m_prev[m_next[t]] = m_prev[t];
+    }
+  }
+
+  std::vector<cell> m_cells;
+  std::vector<std::int32_t> m_next;
+  std::vector<std::int32_t> m_prev;
+  std::vector<std::uint8_t> m_fails;
+  std::int32_t m_head = -1;
+  std::int32_t m_tail = -1;
+};
+
+} // namespace impl::trie_impl
+
+/**
+ * @brief A set of keys compiled to a double-array trie.
+ *
+ * The trie is built once from a runtime list (e.g. symbol names or config
+ * keys read at startup), a lookup walks one cell per input byte. It is
+ * move-only, parsers refer to it so it must outlive them.
+ */
+class trie {
+ public:
+  /**
+   * @brief Compile `keys`, throws `std::invalid_argument` on an empty or
+   * duplicate key. The value of a match is the index of the key in `keys`.
+   */
+  template <std::ranges::input_range R>
+    requires std::convertible_to<std::ranges::range_reference_t<R>, std::string_view>
+  explicit trie(R &&keys) {
+
+    impl::key_views views{YETI_FWD(keys)};
+
+    std::vector<std::string_view> const &key = views.get();
+
+    for (std::string_view k : key) {
+      if (!k.empty()) {
+        m_first = m_first | first_set::of(static_cast<unsigned char>(k.front()));
+      }
+    }
+
+    m_size = key.size();
+    m_cells = impl::trie_impl::builder{}.build(key);
+  }
+
+  trie(trie const &) = delete;
+  trie(trie &&) noexcept = default;
+  auto operator=(trie const &) -> trie & = delete;
+  auto operator=(trie &&) noexcept -> trie & = default;
+  ~trie() = default;
+
+  /**
+   * @brief The number of keys.
+   */
+  [[nodiscard]] auto size() const noexcept -> std::size_t { return m_size; }
+
+  /**
+   * @brief The memory used by the double array.
+   */
+  [[nodiscard]] auto bytes() const noexcept -> std::size_t {
+    return m_cells.size() * sizeof(impl::trie_impl::cell);
+  }
+
+  [[nodiscard]] auto first() const noexcept -> first_set { return m_first; }
+
+  /**
+   * @brief The index of the longest key that prefixes `[it, end)`, or -1, and
+   * the end of the match.
+   */
+  template <std::forward_iterator I, std::sentinel_for<I> E>
+  [[nodiscard]] auto longest(I it, E end) const -> std::pair<std::int32_t, I> {
+
+    std::int32_t s = 0;
+    std::int32_t best = -1;
+
+    I last = it;
+
+    while (it != end) {
+
+      auto c = static_cast<unsigned char>(*it);
+      auto t = static_cast<std::size_t>(m_cells[s].base + c);
+
+      if (t >= m_cells.size() || m_cells[t].check != s) {
+        break;
+      }
+
+      s = static_cast<std::int32_t>(t);
+
+      ++it;
+
+      if (m_cells[s].value >= 0) {
+        best = m_cells[s].value;
+        last = it;
+      }
+    }
+
+    return {best, std::move(last)};
+  }
+
+ private:
+  std::vector<impl::trie_impl::cell> m_cells;
+  std::size_t m_size = 0;
+  first_set m_first;
+};
+
+namespace impl::trie_impl {
+
+struct err {
+  [[nodiscard]] static constexpr auto what() -> std::string_view {
+    return "Expected a key";
+  }
+};
+
+template <typename S>
+concept byte_stream = recombinant_forward_range<S> &&
+                      std::integral<std::ranges::range_value_t<S>> &&
+                      sizeof(std::ranges::range_value_t<S>) == 1;
+
+[[nodiscard]] inline auto deref(trie const *dict) noexcept -> trie const & {
+  return *dict;
+}
+
+[[nodiscard]] inline auto deref(trie const &dict) noexcept -> trie const & {
+  return dict;
+}
+
+// Refers to (`D = trie const *`) or owns (`D = trie`) the trie.
+template <typename D>
+struct matcher {
+
+  static constexpr grammar_info grammar = {tri::no, grammar_info::unbounded};
+
+  D dict;
+
+  [[nodiscard]] auto first() const -> first_set { return deref(dict).first(); }
+
+  template <byte_stream S>
+  [[nodiscard]] auto operator()(S &&stream) const -> resulting_t<S, std::size_t, err> {
+
+    using Exp = std::expected<std::size_t, err>;
+
+    auto end = std::ranges::end(stream);
+
+    auto [idx, last] = deref(dict).longest(std::ranges::begin(stream), end);
+
+    if (idx < 0) {
+      return {YETI_FWD(stream), Exp{std::unexpect}};
+    }
+
+    return {{std::move(last), end}, Exp{static_cast<std::size_t>(idx)}};
+  }
+};
+
+} // namespace impl::trie_impl
+
+/**
+ * @brief Match the longest key of `dict`, the value is its index.
+ *
+ * The parser refers to `dict`, copying it is O(1) whatever the number of
+ * keys. The stream must be a forward range of bytes.
+ */
+[[nodiscard]] inline auto longest(trie const &dict) {
+  return combinate(lift(impl::trie_impl::matcher<trie const *>{&dict}));
+}
+
+/**
+ * @brief As above but the parser owns the trie, it is move-only.
+ */
+[[nodiscard]] inline auto longest(trie &&dict) {
+  return combinate(lift(impl::trie_impl::matcher<trie>{std::move(dict)}));
+}
+
+} // namespace yeti
+
+#endif /* DF320628_790C_443D_A7D4_4EAC4E6B6760 */
@@ -7,6 +7,7 @@
 #include <utility>
 
 #include "yeti/core.hpp"
+#include "yeti/core/analysis.hpp"
 #include "yeti/core/generics.hpp"
 #include "yeti/core/parser_fn.hpp"
 
@@ -46,6 +47,10 @@ struct err {
 template <either<err, unit> E = err>
 struct fail {
 
+  static constexpr grammar_info grammar = {tri::no, 0};
+
+  static constexpr auto first() noexcept -> first_set { return {}; }
+
   static constexpr auto skip() noexcept -> fail<E> { return {}; }
   static constexpr auto mute() noexcept -> fail<unit> { return {}; }
 
@@ -62,6 +67,13 @@ struct fail {
 
 } // namespace impl::fail_impl
 
+namespace impl::simplify_impl {
+
+template <either<fail_impl::err, unit> E>
+inline constexpr bool is_fail<fail_impl::fail<E>> = true;
+
+} // namespace impl::simplify_impl
+
 /**
  * @brief This parser fails without consuming any input.
  */
@@ -75,6 +87,10 @@ namespace impl::pure_impl {
 
 struct pure {
 
+  static constexpr grammar_info grammar = {tri::yes, 0};
+
+  static constexpr auto first() noexcept -> first_set { return {}; }
+
   static constexpr auto skip() noexcept -> pure { return {}; }
   static constexpr auto mute() noexcept -> pure { return {}; }
 
@@ -91,6 +107,16 @@ struct pure {
 
 } // namespace impl::pure_impl
 
+namespace impl::simplify_impl {
+
+template <>
+inline constexpr bool is_pure<pure_impl::pure> = true;
+
+template <>
+inline constexpr bool never_fails<pure_impl::pure> = true;
+
+} // namespace impl::simplify_impl
+
 /**
  * @brief The pure parser always succeeds without consuming any input.
  */
@@ -111,6 +137,10 @@ struct err {
 template <typename E = err>
 struct eos {
 
+  static constexpr grammar_info grammar = {tri::yes, 1};
+
+  static constexpr auto first() noexcept -> first_set { return {}; }
+
   static constexpr auto skip() noexcept -> eos { return {}; }
   static constexpr auto mute() noexcept -> eos<unit> { return {}; }
 
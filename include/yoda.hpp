@@ -7,6 +7,8 @@
 
 #include "yoda/combinators.hpp"
 #include "yoda/core.hpp"
+#include "yoda/each.hpp"
+#include "yoda/parallel.hpp"
 #include "yoda/parsers.hpp"
 
 namespace yoda {
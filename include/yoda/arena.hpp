@@ -0,0 +1,117 @@
+#ifndef F62D8B1A_4C3E_4A97_B5E0_7A1C9D2E6F83
+#define F62D8B1A_4C3E_4A97_B5E0_7A1C9D2E6F83
+
+#include <cstddef>
+#include <forward_list>
+#include <memory_resource>
+#include <mutex>
+
+namespace yoda {
+
+class arena;
+
+namespace detail {
+
+inline thread_local std::pmr::memory_resource *current_resource =
+    std::pmr::new_delete_resource();
+
+// The arena `current_resource` belongs to, if any.
+inline thread_local arena *current_arena = nullptr;
+
+} // namespace detail
+
+/**
+ * @brief The memory resource the container producing combinators use.
+ *
+ * This is per-thread and defaults to `new`/`delete`.
+ */
+inline auto resource() noexcept -> std::pmr::memory_resource * {
+  return detail::current_resource;
+}
+
+/**
+ * @brief A monotonic arena for parse results.
+ *
+ * While a `scope` (see `use`) is alive every container built by `star`,
+ * `plus` and `rep` on this thread is bump-allocated from the arena. Nothing
+ * is freed until `reset` which releases the whole parse result at once,
+ * results must not be used after that. Other threads are unaffected, bar
+ * the workers of `par_many` which allocate from shards of the arena.
+ *
+ * @code
+ * yoda::arena arena;
+ * {
+ *   auto scope = arena.use();
+ *   auto rows = yoda::parse(grammar, input);
+ *   ...
+ * }
+ * arena.reset();
+ * @endcode
+ */
+class arena {
+ public:
+  /**
+   * @brief RAII guard that installs an arena on the current thread.
+   */
+  class [[nodiscard]] scope {
+   public:
+    explicit scope(std::pmr::memory_resource *res, arena *owner = nullptr) noexcept
+        : m_prev{detail::current_resource},
+          m_prev_owner{detail::current_arena} {
+      detail::current_resource = res;
+      detail::current_arena = owner;
+    }
+
+    scope(scope const &) = delete;
+    scope(scope &&) = delete;
+    auto operator=(scope const &) -> scope & = delete;
+    auto operator=(scope &&) -> scope & = delete;
+
+    ~scope() {
+      detail::current_resource = m_prev;
+      detail::current_arena = m_prev_owner;
+    }
+
+   private:
+    std::pmr::memory_resource *m_prev;
+    arena *m_prev_owner;
+  };
+
+  /**
+   * @brief Create an arena whose first block is `initial` bytes.
+   */
+  explicit arena(std::size_t initial = 64 * 1024) : m_mono{initial} {}
+
+  /**
+   * @brief Route this thread's allocations into the arena.
+   */
+  auto use() noexcept -> scope { return scope{&m_mono, this}; }
+
+  /**
+   * @brief Route another thread's allocations into a new shard of the arena.
+   *
+   * A monotonic resource is not thread-safe, hence each thread needs its own.
+   * Shards are freed by `reset` too.
+   */
+  auto share() -> scope {
+    std::scoped_lock lock{m_mutex};
+    return scope{&m_shards.emplace_front(), this};
+  }
+
+  /**
+   * @brief Free everything allocated from the arena in one go.
+   */
+  void reset() noexcept {
+    m_mono.release();
+    m_shards.clear();
+  }
+
+ private:
+  std::pmr::monotonic_buffer_resource m_mono;
+  std::forward_list<std::pmr::monotonic_buffer_resource> m_shards;
+  std::mutex m_mutex;
+};
+
+} // namespace yoda
+
+#endif /* F62D8B1A_4C3E_4A97_B5E0_7A1C9D2E6F83 */
@@ -1,12 +1,16 @@
 #ifndef BD6C0AE4_ED25_4BA6_9686_903FFEBDED6E
 #define BD6C0AE4_ED25_4BA6_9686_903FFEBDED6E
 
+#include <functional>
 #include <limits>
+#include <memory_resource>
 #include <tuple>
 #include <type_traits>
+#include <utility>
 #include <variant>
 #include <vector>
 
+#include "yoda/arena.hpp"
 #include "yoda/core.hpp"
 
 namespace yoda {
@@ -25,7 +29,7 @@ struct map_impl {
       auto r = p(sv);
 
       if (!r) {
-        return {std::unexpected(r.error()), sv};
+        return {std::unexpected(r.error()), r.rest};
       }
 
       return {std::invoke(f, std::move(r).value()), r.rest};
@@ -46,7 +50,7 @@ constexpr detail::map_impl map = {};
  * This maps the result of a parser to `std::monostate`.
  */
 constexpr auto drop = [](parser auto p) -> parser_of<std::monostate> auto {
-  return map(p, [](auto &&) -> std::monostate {
+  return map(std::move(p), [](auto &&) -> std::monostate {
     return {};
   });
 };
@@ -70,13 +74,13 @@ struct seq_impl {
       auto lhs = p(sv);
 
       if (!lhs) {
-        return {std::unexpected(lhs.error()), sv};
+        return {std::unexpected(lhs.error()), lhs.rest};
       }
 
       auto rhs = q(lhs.rest);
 
       if (!rhs) {
-        return {std::unexpected(rhs.error()), lhs.rest};
+        return {std::unexpected(rhs.error()), rhs.rest};
       }
 
       return {Tup{std::move(lhs).value(), std::move(rhs).value()}, rhs.rest};
@@ -88,7 +92,7 @@ struct seq_impl {
    */
   template <parser P, parser Q, parser... Ps>
   constexpr static auto operator()(P p, Q q, Ps... ps) -> parser auto {
-    return seq_impl{}(p, seq_impl{}(q, ps...));
+    return seq_impl{}(std::move(p), seq_impl{}(std::move(q), std::move(ps)...));
   }
 };
 
@@ -106,7 +110,7 @@ constexpr detail::seq_impl seq = {};
  */
 constexpr auto seq_left = []<parser P, parser Q>(P p,
                                                  Q q) -> parser_like<P> auto {
-  return map(seq(p, drop(q)), [](auto &&t) {
+  return map(seq(std::move(p), drop(std::move(q))), [](auto &&t) {
     return std::get<0>(std::forward<decltype(t)>(t));
   });
 };
@@ -154,13 +158,16 @@ struct alt_impl {
 
       constexpr std::string_view fmt = "Both parsers failed with:\n\t{}\n\t{}";
 
-      return {err(fmt, lhs.error(), rhs.error()), sv};
+      // Report the failure that got furthest into the input.
+      auto rest = lhs.rest.size() <= rhs.rest.size() ? lhs.rest : rhs.rest;
+
+      return {err(fmt, lhs.error(), rhs.error()), rest};
     };
   }
 
   template <parser P, parser Q, parser... Ps>
   constexpr static auto operator()(P p, Q q, Ps... ps) -> parser auto {
-    return alt_impl{}(p, alt_impl{}(q, ps...));
+    return alt_impl{}(std::move(p), alt_impl{}(std::move(q), std::move(ps)...));
   }
 };
 
@@ -176,7 +183,7 @@ constexpr detail::alt_impl alt = {};
 namespace detail {
 
 template <parser P>
-using rep_vector_t = std::vector<parser_t<P>>;
+using rep_vector_t = std::pmr::vector<parser_t<P>>;
 
 struct rep_impl {
 
@@ -184,13 +191,13 @@ struct rep_impl {
   constexpr auto operator()(P p, std::size_t min, std::size_t max)
       -> parser_of<rep_vector_t<P>> auto {
 
-    using S = result<std::vector<parser_t<P>>>;
+    using S = result<rep_vector_t<P>>;
 
     constexpr std::string_view fmt = "Expected at least {} repetitions, got {}";
 
     return [=, p = std::move(p)](std::string_view sv) -> S {
       //
-      std::vector<parser_t<P>> acc;
+      rep_vector_t<P> acc(resource());
 
       std::string_view rest = sv;
 
@@ -216,25 +223,114 @@ struct rep_impl {
 
 /**
  * @brief Kleene star combinator.
+ *
+ * Yields a `std::pmr::vector` (not a `std::vector`) allocated from
+ * `resource()`, such that an `arena` can hold a whole parse result.
  */
 constexpr auto star = [](parser auto p) -> parser auto {
-  return detail::rep_impl{}(p, 0, std::numeric_limits<std::size_t>::max());
+  return detail::rep_impl{}(std::move(p), 0, std::numeric_limits<std::size_t>::max());
 };
 
 /**
  * @brief Kleene plus combinator.
+ *
+ * Yields a `std::pmr::vector`, like `star`.
  */
 constexpr auto plus = [](parser auto p) -> parser auto {
-  return detail::rep_impl{}(p, 1, std::numeric_limits<std::size_t>::max());
+  return detail::rep_impl{}(std::move(p), 1, std::numeric_limits<std::size_t>::max());
 };
 
 /**
  * @brief Repetition combinator.
+ *
+ * Yields a `std::pmr::vector` of exactly `n` values, like `star`.
  */
 constexpr auto rep = [](parser auto p, std::size_t n) -> parser auto {
-  return detail::rep_impl{}(p, n, n);
+  return detail::rep_impl{}(std::move(p), n, n);
+};
+
+namespace detail {
+
+template <typename T>
+struct columns_of : std::false_type {};
+
+template <typename... T>
+struct columns_of<std::tuple<T...>> : std::true_type {
+
+  using type = std::tuple<std::vector<T>...>;
+};
+
+template <typename P>
+concept row_parser = parser<P> && columns_of<parser_t<P>>::value;
+
+template <row_parser P>
+using columns_t = columns_of<parser_t<P>>::type;
+
+struct columns_impl {
+  template <row_parser P>
+  static constexpr auto operator()(P p) -> parser_of<columns_t<P>> auto {
+
+    using S = result<columns_t<P>>;
+
+    constexpr auto N = std::tuple_size_v<parser_t<P>>;
+
+    return [p = std::move(p)](std::string_view sv) -> S {
+      //
+      columns_t<P> cols;
+
+      std::string_view rest = sv;
+
+      for (auto r = p(rest); r && r.rest.size() < rest.size(); r = p(rest)) {
+
+        // Estimate the row count from the first row.
+        if (rest.size() == sv.size()) {
+          std::size_t rows = sv.size() / (rest.size() - r.rest.size()) + 1;
+          std::apply([rows](auto &...col) { (col.reserve(rows), ...); }, cols);
+        }
+
+        [&]<std::size_t... I>(std::index_sequence<I...>) {
+          auto row = std::move(r).value();
+          (std::get<I>(cols).push_back(std::get<I>(std::move(row))), ...);
+        }(std::make_index_sequence<N>{});
+
+        rest = r.rest;
+      }
+
+      return {std::move(cols), rest};
+    };
+  }
 };
 
+} // namespace detail
+
+/**
+ * @brief Parse rows into columns (struct-of-arrays).
+ *
+ * Repeats a parser of `std::tuple<T...>` (like `star`) appending each field
+ * to its own contiguous `std::vector<T>`, capacity is reserved from the size
+ * of the first row. Yields `std::tuple<std::vector<T>...>`. The columns are
+ * a handful of large allocations hence, unlike `star`, they do not use the
+ * arena.
+ */
+constexpr detail::columns_impl columns = {};
+
+/**
+ * @brief Invoke `p` through a reference.
+ *
+ * The result is copyable (in O(1)) even if `p` is move-only, `p` must
+ * outlive every parser built from it.
+ */
+template <parser P>
+constexpr auto ref(P const &p) -> parser_of<parser_t<P>> auto {
+  return [&p](std::string_view sv) { return std::invoke(p, sv); };
+}
+
+/**
+ * @brief A reference to a temporary would dangle.
+ */
+template <parser P>
+auto ref(P const &&p) = delete;
+
 } // namespace yoda
 
 #endif /* BD6C0AE4_ED25_4BA6_9686_903FFEBDED6E */
@@ -1,10 +1,13 @@
 #ifndef BFD65DCE_3DE3_4268_95B8_B951A870AF58
 #define BFD65DCE_3DE3_4268_95B8_B951A870AF58
 
+#include <algorithm>
 #include <concepts>
+#include <cstddef>
 #include <expected>
 #include <format>
 #include <functional>
+#include <stdexcept>
 #include <string>
 #include <string_view>
 #include <type_traits>
@@ -20,7 +23,7 @@ namespace yoda {
  * @brief The result of invoking a parser.
  */
 template <typename T> struct result : std::expected<T, std::string> {
-  std::string_view rest;
+  std::string_view rest; ///< Unconsumed input, on failure where the error occurred.
 };
 
 namespace detail {
@@ -39,11 +42,13 @@ concept is_result = parser_impl<P>::value;
 /**
  * @brief Core concept for a parser.
  *
- * A parser is expected to be cheaply copyable.
+ * A parser need only be movable, combinators take their arguments by value
+ * so a move-only parser (one owning a large table) must be moved into them
+ * or shared with `ref`.
  */
 template <typename P>
 concept parser =
-    std::copy_constructible<P> && requires(P parser, std::string_view sv) {
+    std::move_constructible<P> && requires(P parser, std::string_view sv) {
       { std::invoke(parser, sv) } -> detail::is_result;
     };
 
@@ -64,12 +69,75 @@ template <typename P, typename Ref>
 concept parser_like = parser<Ref> && parser_of<P, parser_t<Ref>>;
 
 /**
- * @brief Attempt to parse a string with a parser.
+ * @brief A parse failure, located in the input.
  *
- * This throws an exception if the parse fails.
+ * Only the offset is stored, the line/column and the context snippet are
+ * computed on demand and alias the input (which must outlive this object).
  */
-template <typename P>
-constexpr auto parse(P p, std::string_view sv) -> parser_t<P> {
+struct failure {
+
+  std::string message;    ///< The error reported by the parser.
+  std::string_view input; ///< The input that was parsed.
+  std::size_t offset;     ///< Byte offset of the error in the input.
+
+  /**
+   * @brief The one-based line of the error.
+   */
+  [[nodiscard]] constexpr auto line() const noexcept -> std::size_t {
+    auto newlines = std::ranges::count(input.substr(0, offset), '\n');
+    return static_cast<std::size_t>(newlines) + 1;
+  }
+
+  /**
+   * @brief The one-based (byte) column of the error.
+   */
+  [[nodiscard]] constexpr auto column() const noexcept -> std::size_t {
+    std::size_t nl = input.substr(0, offset).rfind('\n');
+    return nl == std::string_view::npos ? offset + 1 : offset - nl;
+  }
+
+  /**
+   * @brief At most `width` bytes of the failing line, around the error.
+   */
+  [[nodiscard]] constexpr auto
+  context(std::size_t width) const noexcept -> std::string_view {
+
+    std::size_t beg = input.substr(0, offset).rfind('\n');
+    std::size_t end = input.find('\n', offset);
+
+    beg = beg == std::string_view::npos ? 0 : beg + 1;
+    end = end == std::string_view::npos ? input.size() : end;
+
+    if (end - beg > width) {
+      beg = std::min(offset - std::min(offset - beg, width / 2), end - width);
+      end = beg + width;
+    }
+
+    return input.substr(beg, end - beg);
+  }
+
+  /**
+   * @brief Format the error, this is the only allocation on the error path.
+   */
+  [[nodiscard]] auto what(std::size_t width = 64) const -> std::string {
+
+    std::string_view ctx = context(width);
+
+    std::size_t caret = offset - static_cast<std::size_t>(ctx.data() - input.data());
+
+    constexpr std::string_view fmt =
+        "Parser error at {}:{} (offset {}):\n\t{}\n\t{}\n\t{:>{}}";
+
+    return std::format(fmt, line(), column(), offset, message, ctx, '^', caret + 1);
+  }
+};
+
+/**
+ * @brief Attempt to parse a string with a parser, without throwing.
+ */
+template <parser P>
+constexpr auto
+try_parse(P p, std::string_view sv) -> std::expected<parser_t<P>, failure> {
 
   auto r = p(sv);
 
@@ -77,9 +145,29 @@ constexpr auto parse(P p, std::string_view sv) -> parser_t<P> {
     return std::move(r).value();
   }
 
-  constexpr std::string_view fmt = "Parser error:\n\t{}\nRemainder:\n\t{}";
+  // `rest` is always a suffix of `sv` (possibly a null view at the end).
+  std::size_t offset = sv.size() - r.rest.size();
+
+  return std::unexpected(failure{std::move(r).error(), sv, offset});
+}
+
+/**
+ * @brief Attempt to parse a string with a parser.
+ *
+ * This throws an exception if the parse fails, the message includes at most
+ * `context` bytes of the input around the error.
+ */
+template <parser P>
+constexpr auto
+parse(P p, std::string_view sv, std::size_t context = 64) -> parser_t<P> {
+
+  auto r = try_parse(std::move(p), sv);
+
+  if (r) {
+    return std::move(r).value();
+  }
 
-  throw std::runtime_error(std::format(fmt, r.error(), r.rest));
+  throw std::runtime_error(r.error().what(context));
 }
 
 } // namespace yoda
@@ -0,0 +1,132 @@
+#ifndef C5B9A3E1_7D24_4F6A_8E0B_2A9C6D1F4E37
+#define C5B9A3E1_7D24_4F6A_8E0B_2A9C6D1F4E37
+
+#include <cstddef>
+#include <iterator>
+#include <optional>
+#include <string_view>
+#include <utility>
+
+#include "yoda/combinators.hpp"
+#include "yoda/core.hpp"
+
+namespace yoda {
+
+/**
+ * @brief A lazy input range of the records parsed by `P`.
+ *
+ * Each increment parses one more record into a reused slot, iteration stops
+ * at the end of the input or at the first error which is then available via
+ * `error()`. Iterators point into the range so it must outlive them.
+ */
+template <parser P>
+class each_view {
+ public:
+  using value_type = parser_t<P>;
+
+  class iterator {
+   public:
+    using value_type = each_view::value_type;
+    using difference_type = std::ptrdiff_t;
+
+    iterator() = default;
+
+    explicit iterator(each_view *parent) noexcept : m_parent{parent} {}
+
+    auto operator*() const noexcept -> value_type & { return *m_parent->m_value; }
+
+    auto operator++() -> iterator & {
+      m_parent->advance();
+      return *this;
+    }
+
+    void operator++(int) { ++*this; }
+
+    friend auto operator==(iterator const &it, std::default_sentinel_t) noexcept -> bool {
+      return !it.m_parent->m_value;
+    }
+
+   private:
+    each_view *m_parent = nullptr;
+  };
+
+  constexpr each_view(P p, std::string_view sv)
+      : m_parser{std::move(p)},
+        m_input{sv},
+        m_rest{sv} {}
+
+  /**
+   * @brief Parse the first record, call at most once.
+   */
+  auto begin() -> iterator {
+    advance();
+    return iterator{this};
+  }
+
+  static auto end() noexcept -> std::default_sentinel_t { return {}; }
+
+  /**
+   * @brief The error that stopped the iteration, if any.
+   */
+  [[nodiscard]] auto error() const noexcept -> std::optional<failure> const & {
+    return m_error;
+  }
+
+  /**
+   * @brief The input which has not been parsed yet.
+   */
+  [[nodiscard]] auto rest() const noexcept -> std::string_view { return m_rest; }
+
+ private:
+  void advance() {
+
+    m_value.reset();
+
+    if (m_rest.empty()) {
+      return;
+    }
+
+    auto r = m_parser(m_rest);
+
+    std::size_t offset = m_input.size() - r.rest.size();
+
+    if (!r) {
+      m_error.emplace(std::move(r).error(), m_input, offset);
+      return;
+    }
+
+    if (r.rest.size() == m_rest.size()) {
+      m_error.emplace("Record parser consumed no input", m_input, offset);
+      return;
+    }
+
+    m_value.emplace(std::move(r).value());
+    m_rest = r.rest;
+  }
+
+  P m_parser;
+  std::string_view m_input;
+  std::string_view m_rest;
+  std::optional<value_type> m_value;
+  std::optional<failure> m_error;
+};
+
+/**
+ * @brief Lazily parse `sv` as a sequence of records.
+ *
+ * Unlike `parse(star(p), sv)` only a single record is alive at a time:
+ *
+ * @code
+ * auto records = parse_each(line, input);
+ * auto sum = std::ranges::fold_left(records, 0, std::plus{});
+ * if (records.error()) { ... }
+ * @endcode
+ */
+template <parser P>
+constexpr auto parse_each(P p, std::string_view sv) -> each_view<P> {
+  return {std::move(p), sv};
+}
+
+} // namespace yoda
+
+#endif /* C5B9A3E1_7D24_4F6A_8E0B_2A9C6D1F4E37 */
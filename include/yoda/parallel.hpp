@@ -0,0 +1,315 @@
+#ifndef D0C6E2B7_41A8_4F3E_9C5D_8E2F1A7B3C64
+#define D0C6E2B7_41A8_4F3E_9C5D_8E2F1A7B3C64
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <iterator>
+#include <limits>
+#include <mutex>
+#include <optional>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include "yoda/arena.hpp"
+#include "yoda/combinators.hpp"
+#include "yoda/core.hpp"
+
+namespace yoda {
+
+/**
+ * @brief Tuning knobs for `par_many`.
+ */
+struct par_options {
+  std::size_t chunk = 256 * 1024;      ///< Target bytes per chunk (~L2 sized).
+  std::size_t threshold = 1024 * 1024; ///< Smaller inputs are parsed serially.
+  std::size_t threads = std::max(1U, std::thread::hardware_concurrency()); ///< Pool size.
+};
+
+namespace detail {
+
+/**
+ * @brief A range of task indices that the owner pops from the front and
+ * thieves pop from the back, both ends live in one atomic word.
+ */
+class alignas(64) steal_range {
+ public:
+  constexpr steal_range() noexcept = default;
+
+  void reset(std::uint32_t beg, std::uint32_t end) noexcept {
+    m_bits.store(pack(beg, end), std::memory_order_relaxed);
+  }
+
+  auto pop_front() noexcept -> std::optional<std::uint32_t> {
+    return pop([](std::uint32_t b, std::uint32_t e) {
+      return std::pair{pack(b + 1, e), b};
+    });
+  }
+
+  auto pop_back() noexcept -> std::optional<std::uint32_t> {
+    return pop([](std::uint32_t b, std::uint32_t e) {
+      return std::pair{pack(b, e - 1), e - 1};
+    });
+  }
+
+ private:
+  static constexpr auto
+  pack(std::uint32_t beg, std::uint32_t end) noexcept -> std::uint64_t {
+    return (std::uint64_t{end} << 32U) | beg;
+  }
+
+  auto pop(auto next) noexcept -> std::optional<std::uint32_t> {
+
+    std::uint64_t old = m_bits.load(std::memory_order_relaxed);
+
+    for (;;) {
+
+      auto beg = static_cast<std::uint32_t>(old);
+      auto end = static_cast<std::uint32_t>(old >> 32U);
+
+      if (beg >= end) {
+        return std::nullopt;
+      }
+
+      auto [bits, task] = next(beg, end);
+
+      if (m_bits.compare_exchange_weak(old, bits, std::memory_order_acq_rel)) {
+        return task;
+      }
+    }
+  }
+
+  std::atomic<std::uint64_t> m_bits = 0;
+};
+
+/**
+ * @brief Run `fn(task)` for every task in `[0, n)` on `threads` threads.
+ *
+ * Each thread starts with a contiguous block of tasks (good locality) and,
+ * once it runs dry, steals single tasks from the back of the other blocks.
+ * The calling thread participates. The first exception thrown is rethrown.
+ * Each thread holds the result of `setup()` while it runs tasks.
+ */
+template <typename F, typename G>
+void for_each_stealing(std::size_t n, std::size_t threads, F const &fn, G const &setup) {
+
+  threads = std::clamp<std::size_t>(threads, 1, std::max<std::size_t>(n, 1));
+
+  std::vector<steal_range> ranges(threads);
+
+  for (std::size_t i = 0; i < threads; ++i) {
+    ranges[i].reset(static_cast<std::uint32_t>(i * n / threads),
+                    static_cast<std::uint32_t>((i + 1) * n / threads));
+  }
+
+  std::exception_ptr error;
+  std::mutex error_mutex;
+
+  auto work = [&](std::size_t self) noexcept {
+    try {
+      [[maybe_unused]] auto guard = setup();
+
+      while (auto task = ranges[self].pop_front()) {
+        fn(std::size_t{*task});
+      }
+      for (std::size_t k = 1; k < threads; ++k) {
+        while (auto task = ranges[(self + k) % threads].pop_back()) {
+          fn(std::size_t{*task});
+        }
+      }
+    } catch (...) {
+      std::scoped_lock lock{error_mutex};
+      if (!error) {
+        error = std::current_exception();
+      }
+    }
+  };
+
+  {
+    std::vector<std::jthread> pool;
+
+    pool.reserve(threads - 1);
+
+    for (std::size_t i = 1; i < threads; ++i) {
+      pool.emplace_back(work, i);
+    }
+
+    work(0);
+  }
+
+  if (error) {
+    std::rethrow_exception(error);
+  }
+}
+
+/**
+ * @brief Split `sv` after separators into chunks of roughly `size` bytes.
+ */
+inline auto split_chunks(std::string_view sv, char sep, std::size_t size)
+    -> std::vector<std::string_view> {
+
+  std::vector<std::string_view> chunks;
+
+  chunks.reserve(sv.size() / std::max<std::size_t>(size, 1) + 1);
+
+  while (!sv.empty()) {
+
+    std::size_t cut = size < sv.size() ? sv.find(sep, size) : std::string_view::npos;
+
+    std::size_t len = cut == std::string_view::npos ? sv.size() : cut + 1;
+
+    chunks.push_back(sv.substr(0, len));
+    sv.remove_prefix(len);
+  }
+
+  return chunks;
+}
+
+/**
+ * @brief Parse every `sep` terminated record in `chunk` appending to `out`.
+ *
+ * On failure the returned `rest` is a suffix of `whole` such that the
+ * offset of the error is global.
+ */
+template <parser P>
+auto parse_records(P const &p,
+                   char sep,
+                   std::string_view whole,
+                   std::string_view chunk,
+                   std::vector<parser_t<P>> &out) -> result<std::monostate> {
+
+  auto global = [whole](char const *pos) -> std::string_view {
+    return whole.substr(static_cast<std::size_t>(pos - whole.data()));
+  };
+
+  while (!chunk.empty()) {
+
+    std::size_t n = chunk.find(sep);
+
+    std::string_view rec = chunk.substr(0, n);
+
+    auto r = p(rec);
+
+    // An empty `rest` may be a null view, pin it to the end of the record.
+    char const *pos = r.rest.empty() ? rec.data() + rec.size() : r.rest.data();
+
+    if (!r) {
+      return {std::unexpected(std::move(r).error()), global(pos)};
+    }
+
+    if (!r.rest.empty()) {
+      constexpr std::string_view fmt = "Record not fully consumed, {} bytes left";
+
+      return {err(fmt, r.rest.size()), global(pos)};
+    }
+
+    out.push_back(std::move(r).value());
+
+    chunk.remove_prefix(n == std::string_view::npos ? chunk.size() : n + 1);
+  }
+
+  return {{}, {}};
+}
+
+struct par_many_impl {
+  template <parser P>
+  static constexpr auto operator()(P p, char sep, par_options opt = {})
+      -> parser_of<std::vector<parser_t<P>>> auto {
+
+    using V = std::vector<parser_t<P>>;
+    using S = result<V>;
+
+    return [=, p = std::move(p)](std::string_view sv) -> S {
+      //
+      if (sv.size() < opt.threshold || opt.threads <= 1) {
+
+        V out;
+
+        if (auto r = parse_records(p, sep, sv, sv, out); !r) {
+          return {std::unexpected(std::move(r).error()), r.rest};
+        }
+
+        return {std::move(out), {}};
+      }
+
+      std::vector chunks = split_chunks(sv, sep, opt.chunk);
+
+      std::vector<V> outs(chunks.size());
+      std::vector<result<std::monostate>> status(chunks.size());
+
+      // Chunks after the first failure need not be parsed.
+      std::atomic<std::size_t> first_bad = std::numeric_limits<std::size_t>::max();
+
+      auto task = [&](std::size_t i) {
+        //
+        if (i > first_bad.load(std::memory_order_relaxed)) {
+          return;
+        }
+
+        status[i] = parse_records(p, sep, sv, chunks[i], outs[i]);
+
+        if (!status[i]) {
+          for (std::size_t j = first_bad.load(); i < j;) {
+            if (first_bad.compare_exchange_weak(j, i)) {
+              break;
+            }
+          }
+        }
+      };
+
+      // Workers allocate where the caller does, from a shard of its arena.
+      auto inherit = [res = resource(), owner = current_arena]() -> arena::scope {
+        if (owner != nullptr) {
+          return owner->share();
+        }
+        return arena::scope{res};
+      };
+
+      for_each_stealing(chunks.size(), opt.threads, task, inherit);
+
+      if (std::size_t i = first_bad.load(); i < chunks.size()) {
+        return {std::unexpected(std::move(status[i]).error()), status[i].rest};
+      }
+
+      std::size_t total = 0;
+
+      for (auto const &out : outs) {
+        total += out.size();
+      }
+
+      V acc;
+
+      acc.reserve(total);
+
+      for (auto &out : outs) {
+        std::ranges::move(out, std::back_inserter(acc));
+      }
+
+      return {std::move(acc), {}};
+    };
+  }
+};
+
+} // namespace detail
+
+/**
+ * @brief Parse `sep` terminated records in parallel.
+ *
+ * The input is cut at separators into cache sized chunks which are parsed
+ * on a work-stealing pool, the records are returned in input order. Each
+ * record must be fully consumed by `p`, a trailing separator is optional.
+ * Error offsets are relative to the whole input, inputs smaller than
+ * `opt.threshold` are parsed on the calling thread. The workers allocate
+ * from the caller's `resource()`, or a shard of its arena, a resource
+ * installed without an arena must be thread-safe.
+ */
+constexpr detail::par_many_impl par_many = {};
+
+} // namespace yoda
+
+#endif /* D0C6E2B7_41A8_4F3E_9C5D_8E2F1A7B3C64 */
@@ -24,7 +24,7 @@ constexpr auto eof = [](std::string_view sv) -> result<std::monostate> {
   if (sv.empty()) {
     return {{}, {}};
   }
-  return {detail::err("Expected EoF but got '{}'", sv), sv};
+  return {detail::err("Expected EoF but got '{}'", sv[0]), sv};
 };
 
 /**
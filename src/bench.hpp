@@ -0,0 +1,29 @@
+#ifndef B1FAE851_EBF1_4E81_B7E1_D56AA1EA674A
+#define B1FAE851_EBF1_4E81_B7E1_D56AA1EA674A
+
+#include <algorithm>
+#include <chrono>
+#include <limits>
+
+/**
+ * @brief Best of `reps` wall-clock times of `fn()` in milliseconds.
+ */
+auto best_ms(auto const &fn, int reps = 5) -> double {
+
+  double best = std::numeric_limits<double>::max();
+
+  for (int i = 0; i < reps; ++i) {
+
+    auto beg = std::chrono::steady_clock::now();
+
+    fn();
+
+    std::chrono::duration<double, std::milli> dt = std::chrono::steady_clock::now() - beg;
+
+    best = std::min(best, dt.count());
+  }
+
+  return best;
+}
+
+#endif /* B1FAE851_EBF1_4E81_B7E1_D56AA1EA674A */
@@ -0,0 +1,128 @@
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <limits>
+#include <new>
+#include <print>
+#include <random>
+#include <string>
+#include <string_view>
+
+#include "yeti/core.hpp"
+#include "yeti/generic/range.hpp"
+#include "yoda.hpp"
+
+namespace {
+
+std::size_t allocations = 0;
+
+} // namespace
+
+auto operator new(std::size_t size) -> void * {
+  ++allocations;
+  if (void *ptr = std::malloc(std::max<std::size_t>(size, 1))) {
+    return ptr;
+  }
+  throw std::bad_alloc{};
+}
+
+void operator delete(void *ptr) noexcept { std::free(ptr); }
+
+void operator delete(void *ptr, std::size_t) noexcept { std::free(ptr); }
+
+namespace {
+
+/**
+ * @brief Lines of space separated words over {a, b}.
+ */
+auto synthetic(std::size_t lines) -> std::string {
+
+  std::mt19937 gen{42};
+  std::uniform_int_distribution<int> len{1, 8};
+  std::uniform_int_distribution<int> ab{0, 1};
+
+  std::string out;
+
+  for (std::size_t i = 0; i < lines; ++i) {
+    for (int w = len(gen); w > 0; --w) {
+      for (int c = len(gen); c > 0; --c) {
+        out += ab(gen) ? 'a' : 'b';
+      }
+      out += w > 1 ? " " : "\n";
+    }
+  }
+
+  return out;
+}
+
+} // namespace
+
+int main() {
+
+  using namespace yoda;
+
+  std::string input = synthetic(100'000);
+
+  parser auto word = plus(alt(lit('a'), lit('b')));
+  parser auto line = seq_left(plus(seq_left(word, star(ws))), eol);
+  parser auto file = star(line);
+
+  auto run = [&](char const *name, auto &&setup) {
+    //
+    std::size_t before = allocations;
+
+    auto beg = std::chrono::steady_clock::now();
+
+    std::size_t rows = setup();
+
+    std::chrono::duration<double, std::milli> dt = std::chrono::steady_clock::now() - beg;
+
+    std::println("{:<8} rows={} allocations={:>9} time={:>8.2f} ms",
+                 name,
+                 rows,
+                 allocations - before,
+                 dt.count());
+  };
+
+  run("heap", [&] {
+    return parse(file, input).size();
+  });
+
+  arena arena{1 << 20};
+
+  run("arena", [&] {
+    std::size_t rows = 0;
+    {
+      auto scope = arena.use();
+      rows = parse(file, input).size();
+    }
+    arena.reset();
+    return rows;
+  });
+
+  // The same grammar in yeti, a line is a vector of words.
+  auto ab = yeti::alt(yeti::lit('a'), yeti::lit('b'));
+  auto yword = yeti::then(ab, yeti::many(ab));
+  auto ygap = yeti::many(yeti::lit(' ')).drop();
+  auto yline = yeti::then(yeti::many(yeti::then(yword, ygap)), yeti::lit('\n'));
+  auto yfile = yeti::many(yline);
+
+  run("yeti", [&] {
+    return yfile(std::string_view{input}).expected.value().size();
+  });
+
+  yeti::arena yarena{1 << 20};
+
+  run("yarena", [&] {
+    std::size_t rows = 0;
+    {
+      auto scope = yarena.use();
+      rows = yfile(std::string_view{input}).expected.value().size();
+    }
+    yarena.reset();
+    return rows;
+  });
+
+  return 0;
+}
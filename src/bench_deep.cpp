@@ -0,0 +1,75 @@
+#include <cstddef>
+#include <print>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+#include "bench.hpp"
+#include "yeti/core.hpp"
+#include "yeti/generic/range.hpp"
+#include "yeti/generic/recursive.hpp"
+#include "yeti/generic/trivial.hpp"
+
+namespace {
+
+using namespace yeti;
+
+// Balanced parentheses: any number of `(` body `)`.
+constexpr auto body = [](auto self) {
+  return many(then(lit('(').mute(), self, lit(')').mute()).skip());
+};
+
+/**
+ * @brief `n` groups of `depth` nested parentheses.
+ */
+auto synthetic(std::size_t n, std::size_t depth) -> std::string {
+
+  std::string group = std::string(depth, '(') + std::string(depth, ')');
+
+  std::string out;
+
+  for (std::size_t i = 0; i < n; ++i) {
+    out += group;
+  }
+
+  return out;
+}
+
+} // namespace
+
+int main() {
+
+  auto native = recursive<std::string_view, unit>(body);
+  auto bounded = recursive<std::string_view, unit>(body, {.max_depth = 10'000'000});
+
+  auto check = [](auto const &res) {
+    if (!res || !res.unparsed.empty()) {
+      throw std::runtime_error("Benchmark failed to parse");
+    }
+  };
+
+  std::string shallow = synthetic(1'000'000, 4);
+
+  double t_native = best_ms([&] {
+    check(native(std::string_view{shallow}));
+  });
+
+  double t_bounded = best_ms([&] {
+    check(bounded(std::string_view{shallow}));
+  });
+
+  std::println("shallow, native stack:   {:>8.2f} ms", t_native);
+  std::println("shallow, depth_options:  {:>8.2f} ms ({:+.1f}%)",
+               t_bounded,
+               100 * (t_bounded / t_native - 1));
+
+  std::string deep = synthetic(1, 1'000'000);
+
+  double t_deep = best_ms([&] {
+    check(bounded(std::string_view{deep}));
+  });
+
+  std::println("1e6 levels, segmented:   {:>8.2f} ms", t_deep);
+
+  return 0;
+}
@@ -0,0 +1,177 @@
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <functional>
+#include <print>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+#include "bench.hpp"
+#include "yeti/core.hpp"
+#include "yeti/generic/expression.hpp"
+#include "yeti/generic/range.hpp"
+#include "yeti/generic/recursive.hpp"
+
+namespace {
+
+using namespace yeti;
+
+struct not_number {
+  static constexpr auto what() noexcept -> std::string_view {
+    return "Expected a number";
+  }
+};
+
+/**
+ * @brief Parse an unsigned decimal.
+ */
+struct number_fn {
+
+  using type = std::string_view;
+
+  static constexpr auto
+  operator()(std::string_view s) -> result<std::string_view, std::uint64_t, not_number> {
+
+    std::size_t n = 0;
+    std::uint64_t val = 0;
+
+    for (; n < s.size() && s[n] >= '0' && s[n] <= '9'; ++n) {
+      val = 10 * val + static_cast<std::uint64_t>(s[n] - '0');
+    }
+
+    if (n == 0) {
+      return {s, std::expected<std::uint64_t, not_number>{std::unexpect}};
+    }
+
+    return {s.substr(n), val};
+  }
+};
+
+constexpr auto number = combinate(lift(number_fn{}));
+
+/**
+ * @brief A random expression over + - * / and parentheses, unary minus.
+ */
+auto synthetic(std::size_t terms) -> std::string {
+
+  std::mt19937 gen{42};
+  std::uniform_int_distribution<int> num{1, 999};
+  std::uniform_int_distribution<int> pick{0, 9};
+
+  constexpr std::string_view ops = "+-*/";
+
+  std::string out;
+  int depth = 0;
+
+  for (std::size_t i = 0; i < terms; ++i) {
+
+    if (i > 0) {
+      out += ops[static_cast<std::size_t>(pick(gen)) % 4];
+    }
+
+    if (pick(gen) == 0) {
+      out += '-';
+    }
+
+    if (pick(gen) < 2 && depth < 4) {
+      out += '(';
+      ++depth;
+    }
+
+    out += std::to_string(num(gen));
+
+    if (depth > 0 && pick(gen) < 2) {
+      out += ')';
+      --depth;
+    }
+  }
+
+  out.append(static_cast<std::size_t>(depth), ')');
+
+  return out;
+}
+
+/**
+ * @brief One layer per precedence level, recognition only.
+ */
+auto layered() {
+  return recursive<std::string_view, unit>([](auto self) {
+    auto atom = alt(number.drop(), then(lit('('), self, lit(')')).drop());
+    auto unary = then(many(lit('-').drop()), atom);
+    auto prod = then(unary, many(then(alt(lit('*'), lit('/')), unary).drop()));
+    return then(prod, many(then(alt(lit('+'), lit('-')), prod).drop())).drop();
+  });
+}
+
+/**
+ * @brief The same grammar with `expression`, recognition only.
+ */
+auto pratt() {
+  return recursive<std::string_view, unit>([](auto self) {
+    return expression(alt(number.drop(), then(lit('('), self, lit(')')).drop()),
+                      infix<1>(lit('+')),
+                      infix<1>(lit('-')),
+                      infix<2>(lit('*')),
+                      infix<2>(lit('/')),
+                      prefix<3>(lit('-')));
+  });
+}
+
+/**
+ * @brief The same grammar with `expression`, evaluating as it parses.
+ */
+auto evaluate() {
+
+  constexpr auto div = [](std::uint64_t a, std::uint64_t b) static {
+    return a / (b == 0 ? 1 : b);
+  };
+
+  return recursive<std::string_view, std::uint64_t>([=](auto self) {
+    return expression(alt(number.mute(), then(lit('(').drop(), self, lit(')').drop())),
+                      infix<1>(lit('+'), std::plus{}),
+                      infix<1>(lit('-'), std::minus{}),
+                      infix<2>(lit('*'), std::multiplies{}),
+                      infix<2>(lit('/'), div),
+                      prefix<3>(lit('-'), std::negate{}));
+  });
+}
+
+} // namespace
+
+int main() {
+
+  std::string input = synthetic(1'000'000);
+
+  auto check = [](auto const &res) {
+    if (!res || !res.unparsed.empty()) {
+      throw std::runtime_error("Benchmark failed to parse");
+    }
+  };
+
+  auto layers = layered();
+  auto climb = pratt();
+  auto eval = evaluate();
+
+  double t_layers = best_ms([&] {
+    check(layers(std::string_view{input}));
+  });
+
+  double t_climb = best_ms([&] {
+    check(climb(std::string_view{input}));
+  });
+
+  double t_eval = best_ms([&] {
+    check(eval(std::string_view{input}));
+  });
+
+  double mb = static_cast<double>(input.size()) / (1 << 20);
+
+  std::println("input: {:.2f} MiB", mb);
+  std::println("layered:             {:>8.2f} ms", t_layers);
+  std::println("expression:          {:>8.2f} ms", t_climb);
+  std::println("expression + values: {:>8.2f} ms", t_eval);
+
+  return 0;
+}
@@ -0,0 +1,119 @@
+#include <algorithm>
+#include <cstddef>
+#include <expected>
+#include <print>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+#include "bench.hpp"
+#include "yeti/core.hpp"
+#include "yeti/generic/range.hpp"
+
+/**
+ * Literal fusion: the same grammars built from `lit`, which fuses, and from
+ * an equivalent opaque `satisfy` predicate, which does not.
+ *
+ * Each kernel is a separate non-inlined function so its object code size
+ * can be compared with e.g. `nm -C -S --size-sort bench_fusion | grep kernel`.
+ */
+
+namespace {
+
+using namespace yeti;
+
+struct mismatch {
+  static constexpr auto what() noexcept -> std::string_view { return "mismatch"; }
+};
+
+/**
+ * @brief A literal that the simplifier cannot see through.
+ */
+auto opaque(char tok) {
+  return satisfy([tok](char c) -> std::expected<unit, mismatch> {
+    if (c == tok) {
+      return {};
+    }
+    return std::unexpected(mismatch{});
+  });
+}
+
+template <bool Fused>
+auto token(char tok) {
+  if constexpr (Fused) {
+    return lit(tok);
+  } else {
+    return opaque(tok);
+  }
+}
+
+// `mul(` repeated, the `then` of literals fuses into one compare.
+template <bool Fused>
+[[gnu::noinline]] auto keyword_kernel(std::string_view in) -> std::size_t {
+  auto kw = then(token<Fused>('m'),
+                token<Fused>('u'),
+                token<Fused>('l'),
+                token<Fused>('('));
+  return many(kw.drop())(in).unparsed.size();
+}
+
+// A run of [a-f], the `alt` fuses into a class and the `many` into a scan.
+template <bool Fused>
+[[gnu::noinline]] auto class_kernel(std::string_view in) -> std::size_t {
+  auto hex = alt(token<Fused>('a'),
+                 token<Fused>('b'),
+                 token<Fused>('c'),
+                 token<Fused>('d'),
+                 token<Fused>('e'),
+                 token<Fused>('f'));
+  return many(hex.drop())(in).unparsed.size();
+}
+
+} // namespace
+
+int main() {
+
+  constexpr std::size_t n = 1 << 24;
+
+  std::string keywords;
+
+  for (std::size_t i = 0; i < n / 4; ++i) {
+    keywords += "mul(";
+  }
+
+  std::string hex(n, 'a');
+
+  std::mt19937 gen{42};
+  std::uniform_int_distribution<int> pick{0, 5};
+
+  std::ranges::generate(hex, [&] {
+    return static_cast<char>('a' + pick(gen));
+  });
+
+  auto check = [](std::size_t rest) {
+    if (rest != 0) {
+      throw std::runtime_error("Benchmark failed to parse");
+    }
+  };
+
+  double t_kw_slow = best_ms([&] { check(keyword_kernel<false>(keywords)); });
+  double t_kw_fast = best_ms([&] { check(keyword_kernel<true>(keywords)); });
+  double t_cls_slow = best_ms([&] { check(class_kernel<false>(hex)); });
+  double t_cls_fast = best_ms([&] { check(class_kernel<true>(hex)); });
+
+  double mb = static_cast<double>(n) / (1 << 20);
+
+  auto row = [mb](std::string_view name, double ms) {
+    std::println("{:<24} {:>8.2f} ms {:>8.1f} MiB/s", name, ms, mb / (ms / 1000));
+  };
+
+  std::println("input: {:.2f} MiB per grammar", mb);
+
+  row("then(lit...) unfused:", t_kw_slow);
+  row("then(lit...) fused:", t_kw_fast);
+  row("many(alt(lit)) unfused:", t_cls_slow);
+  row("many(alt(lit)) fused:", t_cls_fast);
+
+  return 0;
+}
@@ -0,0 +1,160 @@
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <print>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include "bench.hpp"
+#include "yeti/core.hpp"
+#include "yeti/generic/keywords.hpp"
+#include "yeti/generic/range.hpp"
+
+/**
+ * Keyword matching: `keywords<...>` against an `alt` of literal chains, over
+ * a stream of `;` terminated keywords drawn from sets of 4, 32 and 256.
+ *
+ * The `alt` is ordered longest first so that both agree on every input.
+ */
+
+namespace {
+
+using namespace yeti;
+
+/**
+ * @brief The I'th synthetic keyword, 2 to 7 letters, unique by its tail.
+ */
+template <std::size_t I>
+struct word {
+
+  static constexpr std::size_t size = 2 + (I * 7) % 6;
+
+  struct chars {
+    char data[size + 1];
+  };
+
+  static constexpr chars value = [] {
+    chars out{};
+
+    std::uint64_t x = I * 2654435761U + 17;
+
+    for (std::size_t j = 0; j + 2 < size; ++j, x /= 26) {
+      out.data[j] = static_cast<char>('a' + x % 26);
+    }
+
+    out.data[size - 2] = static_cast<char>('a' + I / 26 % 26);
+    out.data[size - 1] = static_cast<char>('a' + I % 26);
+
+    return out;
+  }();
+
+  static constexpr std::string_view view{value.data, size};
+};
+
+template <std::size_t... I>
+constexpr auto hashed(std::index_sequence<I...>) {
+  return keywords<fixed_value{word<I>::value.data}...>;
+}
+
+// Indices sorted by descending keyword length.
+template <std::size_t... I>
+constexpr auto longest_first(std::index_sequence<I...>) {
+
+  std::array<std::size_t, sizeof...(I)> order = {I...};
+  std::array<std::size_t, sizeof...(I)> size = {word<I>::size...};
+
+  std::ranges::sort(order, [&](std::size_t x, std::size_t y) {
+    return std::pair{size[y], x} < std::pair{size[x], y};
+  });
+
+  return order;
+}
+
+template <std::size_t I, std::size_t... J>
+constexpr auto chain(std::index_sequence<J...>) {
+  return then(lit(word<I>::value.data[J])...).skip();
+}
+
+template <std::size_t N, std::size_t... K>
+constexpr auto ordered(std::index_sequence<K...>) {
+
+  static constexpr auto order = longest_first(std::make_index_sequence<N>{});
+
+  return alt(chain<order[K]>(std::make_index_sequence<word<order[K]>::size>{})...);
+}
+
+template <std::size_t N, bool Hashed>
+[[gnu::noinline]] auto kernel(std::string_view in) -> std::size_t {
+  if constexpr (Hashed) {
+    auto kw = hashed(std::make_index_sequence<N>{});
+    return many(then(kw, lit(';')).drop())(in).unparsed.size();
+  } else {
+    auto kw = ordered<N>(std::make_index_sequence<N>{});
+    return many(then(kw, lit(';')).drop())(in).unparsed.size();
+  }
+}
+
+template <std::size_t N>
+auto input(std::size_t bytes) -> std::string {
+
+  constexpr auto views = []<std::size_t... I>(std::index_sequence<I...>) {
+    return std::array<std::string_view, N>{word<I>::view...};
+  }(std::make_index_sequence<N>{});
+
+  std::mt19937 gen{42};
+  std::uniform_int_distribution<std::size_t> pick{0, N - 1};
+
+  std::string out;
+
+  while (out.size() < bytes) {
+    out += views[pick(gen)];
+    out += ';';
+  }
+
+  return out;
+}
+
+template <std::size_t N>
+void run(std::size_t bytes) {
+
+  std::string in = input<N>(bytes);
+
+  auto check = [](std::size_t rest) {
+    if (rest != 0) {
+      throw std::runtime_error("Benchmark failed to parse");
+    }
+  };
+
+  double t_alt = best_ms([&] { check(kernel<N, false>(in)); });
+  double t_hash = best_ms([&] { check(kernel<N, true>(in)); });
+
+  double mb = static_cast<double>(in.size()) / (1 << 20);
+
+  std::println("{:>4} keywords: alt {:>8.2f} ms {:>8.1f} MiB/s | "
+               "keywords {:>8.2f} ms {:>8.1f} MiB/s | x{:.2f}",
+               N,
+               t_alt,
+               mb / (t_alt / 1000),
+               t_hash,
+               mb / (t_hash / 1000),
+               t_alt / t_hash);
+}
+
+} // namespace
+
+int main() {
+
+  constexpr std::size_t bytes = 1 << 24;
+
+  std::println("input: {:.2f} MiB per set", static_cast<double>(bytes) / (1 << 20));
+
+  run<4>(bytes);
+  run<32>(bytes);
+  run<256>(bytes);
+
+  return 0;
+}
@@ -0,0 +1,92 @@
+#include <cstddef>
+#include <print>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+#include "bench.hpp"
+#include "yeti/core.hpp"
+#include "yeti/generic/memo.hpp"
+#include "yeti/generic/range.hpp"
+#include "yeti/generic/recursive.hpp"
+#include "yeti/generic/trivial.hpp"
+
+namespace {
+
+using namespace yeti;
+
+/**
+ * @brief `x` wrapped in `depth` pairs of parentheses each followed by 'b'.
+ */
+auto nested(int depth) -> std::string {
+  return std::string(depth, '(') + 'x' + [&] {
+    std::string tail;
+    for (int i = 0; i < depth; ++i) {
+      tail += ")b";
+    }
+    return tail;
+  }();
+}
+
+/**
+ * @brief A grammar that tries `(E)a` before `(E)b`.
+ *
+ * Every level parses its nested expression twice without memoization which
+ * is 2^depth work, with it each position is parsed once.
+ */
+template <bool Memo>
+auto grammar(packrat &ctx) {
+  return recursive<std::string_view, unit>([&ctx](auto self) {
+    auto inner = [&] {
+      if constexpr (Memo) {
+        return memo(self, ctx);
+      } else {
+        return self;
+      }
+    }();
+
+    auto a = then(lit('('), inner, lit(')'), lit('a')).drop();
+    auto b = then(lit('('), inner, lit(')'), lit('b')).drop();
+
+    return alt(a, b, lit('x').drop());
+  });
+}
+
+} // namespace
+
+int main() {
+
+  packrat ctx;
+
+  auto plain = grammar<false>(ctx);
+  auto cached = grammar<true>(ctx);
+
+  std::println("{:>6} {:>12} {:>12} {:>10}", "depth", "plain ms", "memo ms", "entries");
+
+  for (int depth = 4; depth <= 22; depth += 3) {
+
+    std::string input = nested(depth);
+
+    auto check = [](auto const &res) {
+      if (!res || !res.unparsed.empty()) {
+        throw std::runtime_error("Benchmark failed to parse");
+      }
+    };
+
+    double slow = best_ms([&] {
+      check(plain(std::string_view{input}));
+    }, 3);
+
+    std::size_t entries = 0;
+
+    double fast = best_ms([&] {
+      ctx.clear();
+      check(cached(std::string_view{input}));
+      entries = ctx.size();
+    }, 3);
+
+    std::println("{:>6} {:>12.3f} {:>12.3f} {:>10}", depth, slow, fast, entries);
+  }
+
+  return 0;
+}
@@ -0,0 +1,104 @@
+#include <cstddef>
+#include <cstring>
+#include <expected>
+#include <format>
+#include <print>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <typeinfo>
+
+#include "bench.hpp"
+#include "yeti/core.hpp"
+#include "yeti/generic/opaque.hpp"
+#include "yeti/generic/range.hpp"
+
+/**
+ * The throughput of `mul(x,y);` records parsed by the inlined grammar, with
+ * the record behind `opaque` (one indirect call per record) and with each
+ * number behind `opaque` (two per record). Each row also prints the length
+ * of the parser's mangled type name and its `sizeof`. Compile time and
+ * object code size are not measured.
+ */
+
+namespace {
+
+using namespace yeti;
+
+struct not_digit {
+  static constexpr auto what() noexcept -> std::string_view { return "Expected a digit"; }
+};
+
+constexpr auto digit = satisfy([](char c) -> std::expected<unit, not_digit> {
+  if (c >= '0' && c <= '9') {
+    return {};
+  }
+  return std::unexpected(not_digit{});
+});
+
+constexpr auto number = then(digit, many(digit.skip())).skip();
+
+template <typename N>
+constexpr auto record(N const &num) {
+  return then(lit('m'), lit('u'), lit('l'), lit('('), num, lit(','), num, lit(')'))
+      .skip();
+}
+
+template <typename P>
+[[gnu::noinline]] auto kernel(P const &parser, std::string_view in) -> std::size_t {
+  return many(then(parser, lit(';')).drop())(in).unparsed.size();
+}
+
+template <typename P>
+auto mangled(P const &) -> std::size_t {
+  return std::strlen(typeid(P).name());
+}
+
+} // namespace
+
+int main() {
+
+  constexpr std::size_t bytes = 1 << 24;
+
+  std::mt19937 gen{42};
+  std::uniform_int_distribution<int> num{0, 99'999};
+
+  std::string in;
+
+  while (in.size() < bytes) {
+    in += std::format("mul({},{});", num(gen), num(gen));
+  }
+
+  auto check = [](std::size_t rest) {
+    if (rest != 0) {
+      throw std::runtime_error("Benchmark failed to parse");
+    }
+  };
+
+  auto inlined = record(number);
+  auto coarse = opaque<std::string_view>(record(number));
+  auto fine = record(opaque<std::string_view>(number));
+
+  double t_inlined = best_ms([&] { check(kernel(inlined, in)); });
+  double t_coarse = best_ms([&] { check(kernel(coarse, in)); });
+  double t_fine = best_ms([&] { check(kernel(fine, in)); });
+
+  double mb = static_cast<double>(in.size()) / (1 << 20);
+
+  auto row = [mb](std::string_view name, double ms, std::size_t sym, std::size_t size) {
+    std::println("{:<26} {:>8.1f} MiB/s {:>6} B name {:>4} B sizeof",
+                 name,
+                 mb / (ms / 1000),
+                 sym,
+                 size);
+  };
+
+  std::println("input: {:.2f} MiB", mb);
+
+  row("inlined:", t_inlined, mangled(inlined), sizeof(inlined));
+  row("opaque(record):", t_coarse, mangled(coarse), sizeof(coarse));
+  row("record(opaque(number)):", t_fine, mangled(fine), sizeof(fine));
+
+  return 0;
+}
@@ -0,0 +1,86 @@
+#include <algorithm>
+#include <cstddef>
+#include <format>
+#include <iterator>
+#include <print>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "bench.hpp"
+#include "yoda.hpp"
+
+namespace {
+
+/**
+ * @brief Lines shaped like `inputs/day_1.txt`.
+ */
+auto synthetic(std::size_t lines) -> std::string {
+
+  std::mt19937 gen{42};
+  std::uniform_int_distribution<int> dist{10000, 99999};
+
+  std::string out;
+
+  out.reserve(lines * 14);
+
+  for (std::size_t i = 0; i < lines; ++i) {
+    std::format_to(std::back_inserter(out), "{}   {}\n", dist(gen), dist(gen));
+  }
+
+  return out;
+}
+
+} // namespace
+
+int main() try {
+
+  using namespace yoda;
+
+  std::string input = synthetic(4'000'000);
+
+  parser auto line = seq(seq_left(number<int>, plus(ws)), number<int>);
+
+  std::size_t expect = parse(par_many(line, '\n', {.threads = 1}), input).size();
+
+  std::println("Input: {} MiB, {} records", input.size() >> 20U, expect);
+
+  double serial = 0;
+
+  std::size_t hw = std::max(1U, std::thread::hardware_concurrency());
+
+  std::vector<std::size_t> counts;
+
+  for (std::size_t t = 1; t < hw; t *= 2) {
+    counts.push_back(t);
+  }
+
+  counts.push_back(hw);
+
+  for (std::size_t t : counts) {
+
+    auto p = par_many(line, '\n', {.threads = t});
+
+    double ms = best_ms([&] {
+      if (parse(p, input).size() != expect) {
+        throw std::runtime_error("par_many dropped records");
+      }
+    });
+
+    serial = t == 1 ? ms : serial;
+
+    std::println("threads={:>3} {:>9.2f} ms  speedup={:>5.2f}  efficiency={:>4.0f}%",
+                 t,
+                 ms,
+                 serial / ms,
+                 100 * serial / ms / static_cast<double>(t));
+  }
+
+  return 0;
+
+} catch (std::exception const &e) {
+  std::println("Error: {}", e.what());
+  return 1;
+}
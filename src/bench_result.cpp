@@ -0,0 +1,153 @@
+#include <concepts>
+#include <cstddef>
+#include <expected>
+#include <print>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+#include "bench.hpp"
+#include "yeti/core.hpp"
+#include "yeti/generic/range.hpp"
+
+/**
+ * Recognizers: words separated by runs of spaces, `then(letter, ...).drop()`
+ * and `many(lit(' ')).drop()`, each invoked through a call that is not
+ * inlined (as across an `opaque` boundary). The compact `result` of the
+ * infallible `spaces` is two pointers, the `std::expected` layout it replaced
+ * is larger and comes back via memory. To see the calling convention build
+ * with `-O2 -S` and read the `across` instantiations: on x86-64 SysV a result
+ * in registers is left in `rax:rdx`, one via memory is stored through `rdi`.
+ */
+
+namespace {
+
+using namespace yeti;
+
+using SV = std::string_view;
+
+/**
+ * @brief The layout of `result` before it was compacted.
+ */
+template <typename T, typename E>
+struct expected_layout {
+
+  using expected_type = std::expected<T, E>;
+
+  SV unparsed;
+  expected_type expected;
+
+  explicit operator bool() const noexcept { return expected.has_value(); }
+};
+
+struct not_letter {
+  static constexpr auto what() noexcept -> std::string_view { return "Expected a-z"; }
+};
+
+constexpr auto letter = satisfy([](char c) -> std::expected<unit, not_letter> {
+  if (c >= 'a' && c <= 'z') {
+    return {};
+  }
+  return std::unexpected(not_letter{});
+});
+
+constexpr auto word = then(letter, many(letter.skip())).drop();
+
+constexpr auto spaces = many(lit(' ')).drop();
+
+static_assert(sizeof(spaces(SV{})) == sizeof(SV));
+
+/**
+ * @brief Invoke `parser` behind a call, returning its result as `R`.
+ */
+template <typename R, typename P>
+[[gnu::noinline]] auto across(P const &parser, SV s) -> R {
+
+  auto r = parser(s);
+
+  if constexpr (std::same_as<R, decltype(r)>) {
+    return r;
+  } else if constexpr (std::same_as<typename R::expected_type::error_type, never>) {
+    return R{r.unparsed, {}};
+  } else if (r) {
+    return R{r.unparsed, {}};
+  } else {
+    return R{r.unparsed, typename R::expected_type{std::unexpect}};
+  }
+}
+
+// Count the words, both recognizers fail only at the end of the input.
+template <typename Word, typename Spaces>
+auto kernel(SV in) -> std::size_t {
+
+  std::size_t n = 0;
+
+  for (;;) {
+
+    auto w = across<Word>(word, in);
+
+    if (!w) {
+      return in.empty() ? n : 0;
+    }
+
+    ++n;
+    in = across<Spaces>(spaces, w.unparsed).unparsed;
+  }
+}
+
+} // namespace
+
+int main() {
+
+  constexpr std::size_t bytes = 1 << 24;
+
+  std::mt19937 gen{42};
+  std::uniform_int_distribution<int> len{1, 8};
+  std::uniform_int_distribution<int> alpha{'a', 'z'};
+
+  std::string in;
+  std::size_t want = 0;
+
+  while (in.size() < bytes) {
+    for (int i = len(gen); i > 0; --i) {
+      in += static_cast<char>(alpha(gen));
+    }
+    in.append(static_cast<std::size_t>(len(gen)) % 3 + 1, ' ');
+    ++want;
+  }
+
+  auto check = [want](std::size_t got) {
+    if (got != want) {
+      throw std::runtime_error("Benchmark counted the wrong number of words");
+    }
+  };
+
+  using compact_word = result<SV, unit, unit>;
+  using compact_spaces = result<SV, unit, never>;
+
+  using old_word = expected_layout<unit, unit>;
+  using old_spaces = expected_layout<unit, never>;
+
+  double t_compact = best_ms([&] { check(kernel<compact_word, compact_spaces>(in)); });
+  double t_old = best_ms([&] { check(kernel<old_word, old_spaces>(in)); });
+
+  double mb = static_cast<double>(in.size()) / (1 << 20);
+
+  std::println("input: {:.2f} MiB, {} words", mb, want);
+
+  std::println("result<sv, unit, unit>  {:>3} B, was {:>3} B",
+               sizeof(compact_word),
+               sizeof(old_word));
+  std::println("result<sv, unit, never> {:>3} B, was {:>3} B",
+               sizeof(compact_spaces),
+               sizeof(old_spaces));
+  std::println("result<sv, size_t, never> {:>3} B, was {:>3} B",
+               sizeof(result<SV, std::size_t, never>),
+               sizeof(expected_layout<std::size_t, never>));
+
+  std::println("compact:         {:>8.1f} MiB/s", mb / (t_compact / 1000));
+  std::println("std::expected:   {:>8.1f} MiB/s", mb / (t_old / 1000));
+
+  return 0;
+}
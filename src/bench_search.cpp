@@ -0,0 +1,134 @@
+#include <cstddef>
+#include <expected>
+#include <print>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "bench.hpp"
+#include "yeti/core.hpp"
+#include "yeti/generic/range.hpp"
+#include "yeti/generic/search.hpp"
+
+/**
+ * Records in noise: count the `mul(x,y)`, `do()` and `don't()` instructions
+ * in random garbage, by trying the grammar at every offset and by `scan`
+ * which only tries it where the automaton found a trigger.
+ */
+
+namespace {
+
+using namespace yeti;
+
+struct not_digit {
+  static constexpr auto what() noexcept -> std::string_view { return "Expected a digit"; }
+};
+
+constexpr auto digit = satisfy([](char c) -> std::expected<unit, not_digit> {
+  if (c >= '0' && c <= '9') {
+    return {};
+  }
+  return std::unexpected(not_digit{});
+});
+
+constexpr auto number = then(digit, many(digit.skip())).skip();
+
+constexpr auto instr = alt(
+    then(lit('m'), lit('u'), lit('l'), lit('('), number, lit(','), number, lit(')'))
+        .skip(),
+    then(lit('d'), lit('o'), lit('('), lit(')')).skip(),
+    then(lit('d'), lit('o'), lit('n'), lit('\''), lit('t'), lit('('), lit(')')).skip());
+
+[[gnu::noinline]] auto every_offset(std::string_view in) -> std::size_t {
+
+  std::size_t n = 0;
+
+  while (!in.empty()) {
+    if (auto [rest, res] = instr(in); res) {
+      ++n;
+      in = rest;
+    } else {
+      in.remove_prefix(1);
+    }
+  }
+
+  return n;
+}
+
+template <typename P>
+[[gnu::noinline]] auto scanning(P const &parser, std::string_view in) -> std::size_t {
+
+  std::size_t n = 0;
+
+  while (true) {
+
+    auto [rest, res] = parser(in);
+
+    if (!res) {
+      return n;
+    }
+
+    ++n;
+    in = rest;
+  }
+}
+
+} // namespace
+
+int main() {
+
+  constexpr std::size_t bytes = 1 << 24;
+
+  std::mt19937 gen{42};
+  std::uniform_int_distribution<int> noise{32, 126};
+  std::uniform_int_distribution<int> roll{0, 99};
+
+  constexpr std::string_view records[] = {"mul(12,345)", "do()", "don't()", "mul(7,x)"};
+
+  std::string in;
+  std::size_t want = 0;
+
+  // About one record (three quarters valid) per hundred bytes of noise.
+  while (in.size() < bytes) {
+    if (roll(gen) == 0) {
+      std::string_view rec = records[static_cast<std::size_t>(roll(gen)) % 4];
+      want += rec != records[3];
+      in += rec;
+    } else {
+      char c = static_cast<char>(noise(gen));
+      in += c == 'm' || c == 'd' ? ' ' : c;
+    }
+  }
+
+  auto check = [want](std::size_t got) {
+    if (got != want) {
+      throw std::runtime_error("Benchmark counted the wrong number of records");
+    }
+  };
+
+  std::vector<std::string> triggers = {"mul(", "do()", "don't()"};
+
+  aho_corasick dict{triggers};
+
+  auto triggered = scan<"mul(", "do()", "don't()">(instr);
+
+  double t_naive = best_ms([&] { check(every_offset(in)); });
+  double t_fixed = best_ms([&] { check(scanning(triggered, in)); });
+  double t_dyn = best_ms([&] { check(scanning(scan(instr, dict), in)); });
+
+  double mb = static_cast<double>(in.size()) / (1 << 20);
+
+  auto row = [mb](std::string_view name, double ms) {
+    std::println("{:<28} {:>8.2f} ms {:>8.1f} MiB/s", name, ms, mb / (ms / 1000));
+  };
+
+  std::println("input: {:.2f} MiB, {} records", mb, want);
+
+  row("parser at every offset:", t_naive);
+  row("scan<\"...\">(parser):", t_fixed);
+  row("scan(parser, aho_corasick):", t_dyn);
+
+  return 0;
+}
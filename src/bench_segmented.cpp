@@ -0,0 +1,165 @@
+#include <algorithm>
+#include <cstddef>
+#include <expected>
+#include <print>
+#include <random>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "bench.hpp"
+#include "yeti/core.hpp"
+#include "yeti/generic/pattern.hpp"
+#include "yeti/generic/range.hpp"
+#include "yeti/generic/segmented.hpp"
+
+namespace {
+
+using namespace yeti;
+
+struct none {
+  static constexpr auto what() noexcept -> std::string_view { return "none"; }
+};
+
+constexpr auto any = satisfy([](char) static -> std::expected<unit, none> {
+  return {};
+});
+
+/**
+ * @brief Count the 'c' tokens in `stream` one token at a time.
+ */
+template <typename S>
+auto count_tokens(S stream) -> std::size_t {
+
+  std::size_t n = 0;
+
+  while (!stream.empty()) {
+    auto [rest, tok] = any(stream);
+    n += static_cast<std::size_t>(*tok == 'c');
+    stream = rest;
+  }
+
+  return n;
+}
+
+/**
+ * @brief Count the 'c' tokens using the contiguous fast path.
+ */
+auto count_segments(segmented<char> stream) -> std::size_t {
+
+  std::size_t n = 0;
+
+  while (!stream.empty()) {
+    auto seg = stream.segment();
+    n += static_cast<std::size_t>(std::ranges::count(seg, 'c'));
+    stream = stream.drop(seg.size());
+  }
+
+  return n;
+}
+
+// Every letter but 'c', the `alt` fuses into a class and the `many` into a span.
+constexpr auto not_c = []<std::size_t... I>(std::index_sequence<I...>) {
+  return many(alt(lit(static_cast<char>('a' + I + (I >= 2)))...)).drop();
+}(std::make_index_sequence<25>{});
+
+/**
+ * @brief Count the 'c' tokens by skipping the runs between them.
+ */
+template <typename S>
+auto count_runs(S stream) -> std::size_t {
+
+  std::size_t n = 0;
+
+  for (stream = not_c(stream).unparsed; !stream.empty(); ++n) {
+    stream = not_c(any(stream).unparsed).unparsed;
+  }
+
+  return n;
+}
+
+constexpr auto record = pattern<"[abd-z]*c">;
+
+/**
+ * @brief Count the 'c' tokens as the records of a pattern.
+ */
+template <typename S>
+auto count_records(S stream) -> std::size_t {
+
+  std::size_t n = 0;
+
+  for (auto r = record(stream); r; r = record(r.unparsed)) {
+    ++n;
+  }
+
+  return n;
+}
+
+} // namespace
+
+int main() {
+
+  std::mt19937 gen{42};
+  std::uniform_int_distribution<int> dist{'a', 'z'};
+
+  std::vector<std::string> buffers(1024, std::string(64 * 1024, ' '));
+
+  for (auto &buf : buffers) {
+    std::ranges::generate(buf, [&] {
+      return static_cast<char>(dist(gen));
+    });
+  }
+
+  std::vector<std::span<char const>> spans(buffers.begin(), buffers.end());
+
+  segmented<char> rope{spans};
+
+  std::size_t expect = count_segments(rope);
+
+  auto check = [expect](std::size_t n) {
+    if (n != expect) {
+      throw std::runtime_error("Benchmark miscounted");
+    }
+  };
+
+  double concat = best_ms([&] {
+    std::string flat;
+    for (auto const &buf : buffers) {
+      flat += buf;
+    }
+    check(count_tokens(std::string_view{flat}));
+  });
+
+  double tokens = best_ms([&] {
+    check(count_tokens(rope));
+  });
+
+  double segments = best_ms([&] {
+    check(count_segments(rope));
+  });
+
+  std::string flat;
+
+  for (auto const &buf : buffers) {
+    flat += buf;
+  }
+
+  double flat_span = best_ms([&] { check(count_runs(std::string_view{flat})); });
+  double rope_span = best_ms([&] { check(count_runs(rope)); });
+
+  double flat_pattern = best_ms([&] { check(count_records(std::string_view{flat})); });
+  double rope_pattern = best_ms([&] { check(count_records(rope)); });
+
+  std::println("concatenate + tokens: {:>8.2f} ms", concat);
+  std::println("segmented tokens:     {:>8.2f} ms", tokens);
+  std::println("segmented fast path:  {:>8.2f} ms", segments);
+  std::println("flat span:            {:>8.2f} ms", flat_span);
+  std::println("segmented span:       {:>8.2f} ms", rope_span);
+  std::println("flat pattern:         {:>8.2f} ms", flat_pattern);
+  std::println("segmented pattern:    {:>8.2f} ms", rope_pattern);
+
+  return 0;
+}
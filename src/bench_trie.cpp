@@ -0,0 +1,220 @@
+#include <algorithm>
+#include <cstddef>
+#include <expected>
+#include <print>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "bench.hpp"
+#include "yeti/core.hpp"
+#include "yeti/generic/range.hpp"
+#include "yeti/generic/trie.hpp"
+
+/**
+ * Runtime keyword sets: `longest(trie)` against two hand-written matchers, a
+ * scan of `starts_with` over the keys longest first (the order in which an
+ * `alt` of the keys would try them, a runtime list cannot build an `alt`) and
+ * an `std::unordered_map` probed with every distinct key length. Each is a
+ * parser run by the same `(key ';')*` driver over a stream of keys.
+ *
+ * All three are longest match so they agree on every input.
+ */
+
+namespace {
+
+using namespace yeti;
+
+// Distinct identifier-like keys of 3 to 20 bytes.
+auto make_keys(std::size_t n) -> std::vector<std::string> {
+
+  constexpr std::string_view alphabet = "abcdefghijklmnopqrstuvwxyz_0123456789";
+
+  std::mt19937 gen{42};
+  std::uniform_int_distribution<std::size_t> len{3, 20};
+  std::uniform_int_distribution<std::size_t> pick{0, alphabet.size() - 1};
+
+  std::unordered_set<std::string> seen;
+  std::vector<std::string> out;
+
+  while (out.size() < n) {
+
+    std::string key(len(gen), ' ');
+
+    std::ranges::generate(key, [&] {
+      return alphabet[pick(gen)];
+    });
+
+    if (seen.insert(key).second) {
+      out.push_back(std::move(key));
+    }
+  }
+
+  return out;
+}
+
+auto make_input(std::vector<std::string> const &keys, std::size_t bytes) -> std::string {
+
+  std::mt19937 gen{7};
+  std::uniform_int_distribution<std::size_t> pick{0, keys.size() - 1};
+
+  std::string out;
+
+  while (out.size() < bytes) {
+    out += keys[pick(gen)];
+    out += ';';
+  }
+
+  return out;
+}
+
+// The unparsed size after `(key ';')*`.
+template <typename P>
+[[gnu::noinline]] auto kernel(P const &key, std::string_view in) -> std::size_t {
+  return many(then(key, lit(';')).drop())(in).unparsed.size();
+}
+
+/**
+ * @brief Try every key with `starts_with`, longest first.
+ */
+struct ordered {
+
+  std::vector<std::string_view> keys;
+
+  explicit ordered(std::vector<std::string> const &from)
+      : keys(from.begin(), from.end()) {
+    std::ranges::stable_sort(keys, std::greater{}, [](std::string_view key) {
+      return key.size();
+    });
+  }
+
+  [[nodiscard]] auto match(std::string_view in) const -> std::size_t {
+    for (std::string_view key : keys) {
+      if (in.starts_with(key)) {
+        return key.size();
+      }
+    }
+    return 0;
+  }
+};
+
+/**
+ * @brief Probe a hash map with each distinct key length, longest first.
+ */
+struct hashed {
+
+  std::unordered_map<std::string_view, std::size_t> keys;
+  std::vector<std::size_t> lengths;
+
+  explicit hashed(std::vector<std::string> const &from) {
+
+    for (std::size_t i = 0; i < from.size(); ++i) {
+      keys.emplace(from[i], i);
+      lengths.push_back(from[i].size());
+    }
+
+    std::ranges::sort(lengths, std::greater{});
+    lengths.erase(std::ranges::unique(lengths).begin(), lengths.end());
+  }
+
+  [[nodiscard]] auto match(std::string_view in) const -> std::size_t {
+    for (std::size_t len : lengths) {
+      if (len <= in.size() && keys.contains(in.substr(0, len))) {
+        return len;
+      }
+    }
+    return 0;
+  }
+};
+
+/**
+ * @brief A parser matching the longest key of `M`.
+ */
+template <typename M>
+struct matcher {
+
+  using type = std::string_view;
+
+  using R = result<std::string_view, unit, unit>;
+
+  M const *keys;
+
+  auto operator()(std::string_view in) const -> R {
+
+    std::size_t n = keys->match(in);
+
+    if (n == 0) {
+      return {in, R::expected_type{std::unexpect}};
+    }
+
+    return {in.substr(n), {}};
+  }
+};
+
+void run(std::size_t n) {
+
+  constexpr std::size_t bytes = 1 << 24;
+  constexpr std::size_t scan_bytes = 1 << 16;
+
+  std::vector<std::string> keys = make_keys(n);
+
+  std::string in = make_input(keys, bytes);
+  std::string small = make_input(keys, scan_bytes);
+
+  auto check = [](std::size_t rest) {
+    if (rest != 0) {
+      throw std::runtime_error("Benchmark failed to parse");
+    }
+  };
+
+  trie dict{keys};
+
+  double t_build = best_ms([&] {
+    trie built{keys};
+    check(built.size() - n);
+  }, 3);
+
+  double t_map_build = best_ms([&] {
+    hashed built{keys};
+    check(built.keys.size() - n);
+  }, 3);
+
+  hashed map{keys};
+  ordered list{keys};
+
+  auto by_map = lift(matcher<hashed>{&map});
+  auto by_scan = lift(matcher<ordered>{&list});
+
+  double t_trie = best_ms([&] { check(kernel(longest(dict), in)); });
+  double t_map = best_ms([&] { check(kernel(by_map, in)); });
+  double t_scan = best_ms([&] { check(kernel(by_scan, small)); }, 1);
+
+  auto mbps = [](std::string const &s, double ms) {
+    return static_cast<double>(s.size()) / (1 << 20) / (ms / 1000);
+  };
+
+  std::println("{} keys", n);
+  std::println("  trie build {:>8.2f} ms, {:>8.1f} KiB ({:.1f} B/key)",
+               t_build,
+               static_cast<double>(dict.bytes()) / 1024,
+               static_cast<double>(dict.bytes()) / static_cast<double>(n));
+  std::println("  map  build {:>8.2f} ms", t_map_build);
+  std::println("  trie  {:>10.1f} MiB/s", mbps(in, t_trie));
+  std::println("  map   {:>10.1f} MiB/s", mbps(in, t_map));
+  std::println("  scan  {:>10.3f} MiB/s", mbps(small, t_scan));
+}
+
+} // namespace
+
+int main() {
+
+  run(1'000);
+  run(10'000);
+  run(50'000);
+
+  return 0;
+}
@@ -5,6 +5,7 @@
 #include <ranges>
 #include <stdexcept>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "yoda.hpp"
@@ -22,25 +23,12 @@ auto parse(std::string const &fname) -> Parsed {
 
   std::string file = yoda::read(fname);
 
-  std::println("{}", file);
+  parser auto row = seq(seq_left(number<int>, plus(ws)), //
+                        seq_left(number<int>, alt(drop(eol), eof)));
 
-  parser auto p = number<int> //
-                      .seq_left(ws.plus())
-                      .seq(number<int>)
-                      .seq_left(eol)
-                      .star();
+  auto [lhs, rhs] = yoda::parse(seq_left(columns(row), eof), file);
 
-  // parser auto line = seq(number<int>, plus(number<int>), );
-
-  // int a = 0;
-  // int b = 0;
-
-  // while (file >> a >> b) {
-  //   parsed.lhs.push_back(a);
-  //   parsed.rhs.push_back(b);
-  // }
-
-  // return parsed;
+  return {std::move(lhs), std::move(rhs)};
 }
 
 namespace views = std::ranges::views;
@@ -1,18 +1,45 @@
 
 
+#include <array>
 #include <concepts>
+#include <cstdio>
 #include <expected>
+#include <functional>
 #include <iostream>
+#include <memory>
+#include <memory_resource>
 #include <print>
+#include <span>
+#include <sstream>
+#include <stdexcept>
 #include <ranges>
+#include <string>
 #include <string_view>
+#include <tuple>
 #include <type_traits>
 #include <utility>
 #include <variant>
+#include <vector>
 
 #include "yeti/core.hpp"
 #include "yeti/core/flat_variant.hpp"
+#include "yeti/generic/budget.hpp"
+#include "yeti/generic/buffered.hpp"
+#include "yeti/generic/expression.hpp"
+#include "yeti/generic/keywords.hpp"
+#include "yeti/generic/locate.hpp"
+#include "yeti/generic/memo.hpp"
+#include "yeti/generic/opaque.hpp"
+#include "yeti/generic/parse.hpp"
+#include "yeti/generic/pattern.hpp"
+#include "yeti/generic/push.hpp"
 #include "yeti/generic/range.hpp"
+#include "yeti/generic/recursive.hpp"
+#include "yeti/generic/ref.hpp"
+#include "yeti/generic/search.hpp"
+#include "yeti/generic/segmented.hpp"
+#include "yeti/generic/speculate.hpp"
+#include "yeti/generic/trie.hpp"
 #include "yeti/generic/trivial.hpp"
 
 using SV = std::string_view;
@@ -35,6 +62,273 @@ constexpr auto o = llit("hj"sv);
 
 static_assert(!o);
 
+// =====
+// =====
+// =====
+
+static_assert(count_newlines("a\nb\n\n"sv) == 3);
+static_assert(locate("ab\ncd"sv, 4) == location{4, 2, 2});
+static_assert(context("0123456789"sv, 5, 4) == "3456"sv);
+static_assert(context("01\n3456789"sv, 1, 4) == "01"sv);
+
+static_assert(parse(lit('h'), "hi"sv).value() == 'h');
+static_assert(parse(lit('h'), "ab\ncd"sv).error().offset == 0);
+static_assert(parse(llit, "cj"sv).value() == 'c');
+
+static_assert(recombinant_forward_range<buffered<istream_source>::view>);
+static_assert(recombinant_forward_range<buffered<fd_source>::view>);
+static_assert(recombinant_forward_range<segmented<char>>);
+
+constexpr auto rope_parse = [] {
+  std::string_view a = "c", b = "", c = "cx";
+  std::span<char const> segs[] = {a, b, c};
+  auto [rest, res] = llit(llit(segmented<char>{segs}).unparsed);
+  return res && rest.segment().size() == 1 && *rest.begin() == 'x';
+};
+
+static_assert(rope_parse());
+
+// Fused literals and patterns scan segment by segment, across the boundaries.
+constexpr auto rope_scan = [] {
+  std::string_view a = "abab", b = "", c = "ba", d = "bcabc;x";
+  std::span<char const> segs[] = {a, b, c, d};
+  segmented<char> rope{segs};
+
+  auto ab = many(alt(lit('a'), lit('b')))(rope);
+  auto abc = then(lit('a'), lit('b'), lit('c')).drop();
+  auto word = pattern<"[ab]*c[a-z]*;">;
+
+  bool ok = ab && ab.expected->size() == 7 && *ab.unparsed.begin() == 'c';
+
+  ok = ok && !abc(rope) && abc(rope.drop(8)).unparsed.segment().size() == 2;
+  ok = ok && abc(rope.drop(5)) && !abc(rope.drop(6));
+
+  auto w = word(rope);
+
+  return ok && w && *w.unparsed.begin() == 'x' && !word(rope.drop(12));
+};
+
+static_assert(rope_scan());
+
+static_assert(lit('a').then(lit('b'))("abc"sv).expected.value() == std::tuple{'a', 'b'});
+static_assert(lit('a').then(lit('b').skip())("abc"sv).expected.value() == 'a');
+static_assert(!then(lit('a'), lit('b'), lit('c'))("abx"sv));
+static_assert(alt(lit('a'), lit('b'))("bc"sv).expected.value() == 'b');
+static_assert(alt(lit('a'), lit('b'))("xc"sv).unparsed == "xc"sv);
+static_assert(many(lit('a'))("aab"sv).expected.value().size() == 2);
+static_assert(many(lit('a').skip())("aab"sv).unparsed == "b"sv);
+
+constexpr auto paren = alt(lit('(').then(lit('x').cut()), lit('y'));
+
+static_assert(paren("(x"sv) && paren("y"sv));
+static_assert(!paren("(y"sv) && paren("(y"sv).unparsed == "y"sv);
+static_assert(!alt(paren, lit('('))("(y"sv));
+static_assert(alt(paren.mute(), lit('('))("(y"sv).unparsed == "y"sv);
+static_assert(!alt(lit('z').alt(paren), lit('('))("(y"sv));
+static_assert(!many(lit('a').then(cut(lit('b'))))("abac"sv));
+static_assert(many(lit('a').then(lit('b')))("abac"sv).unparsed == "ac"sv);
+
+struct digit_fn {
+
+  using type = SV;
+
+  static constexpr auto operator()(SV s) -> result<SV, int, unit> {
+    if (!s.empty() && s[0] >= '0' && s[0] <= '9') {
+      return {s.substr(1), s[0] - '0'};
+    }
+    return {s, std::expected<int, unit>{std::unexpect}};
+  }
+};
+
+constexpr auto arith = expression(lift(digit_fn{}),
+                                  infix<1>(lit('+'), std::plus{}),
+                                  infix<2>(lit('*'), std::multiplies{}),
+                                  infix<3, assoc::right>(lit('^'),
+                                                         [](int a, int b) static {
+                                                           int r = 1;
+                                                           while (b-- > 0) {
+                                                             r *= a;
+                                                           }
+                                                           return r;
+                                                         }),
+                                  prefix<2>(lit('-'), std::negate{}),
+                                  postfix<4>(lit('!'), [](int a) static {
+                                    return a * 10;
+                                  }));
+
+static_assert(arith("1+2*3"sv).expected.value() == 7);
+static_assert(arith("2^3^2"sv).expected.value() == 512);
+static_assert(arith("-2*3+1"sv).expected.value() == -5);
+static_assert(arith("2*-3"sv).expected.value() == -6);
+static_assert(arith("-2^2"sv).expected.value() == -4);
+static_assert(arith("2^-1+1"sv).expected.value() == 2);
+static_assert(arith("2^-1*3"sv).expected.value() == 3);
+static_assert(arith("2*3!"sv).expected.value() == 60);
+static_assert(arith("1+2x"sv).unparsed == "x"sv);
+static_assert(!arith("1+"sv));
+
+static_assert(recombinant_forward_range<metered<SV>>);
+static_assert(budget(many(lit('a')), 4)("aaaa"sv).expected.value().size() == 4);
+static_assert(!budget(many(lit('a')), 3)("aaaa"sv));
+static_assert(budget(many(lit('a')), 3)("aaaa"sv).unparsed == "a"sv);
+static_assert(!budget(alt(lit('a').then(lit('b')), lit('a').then(lit('c'))), 3)("ac"sv));
+
+static_assert(std::same_as<flat_union<unit, unit>, unit>);
+static_assert(std::same_as<flat_union<never, int>, int>);
+static_assert(std::same_as<parse_error_t<decltype(alt(lit('a'), pure)), SV>, never>);
+static_assert(std::same_as<parse_value_t<decltype(lit('a').then(pure)), SV>, char>);
+
+static_assert(grammar_of<decltype(lit('a'))>.nullable == tri::no);
+static_assert(grammar_of<decltype(lit('a'))>.lookahead == 1);
+static_assert(grammar_of<decltype(lit('a').then(lit('b')))>.lookahead == 2);
+static_assert(nullable<decltype(many(lit('a')))>);
+static_assert(nullable<decltype(alt(lit('a'), pure))>);
+static_assert(!nullable<decltype(then(pure, lit('a')))>);
+static_assert(grammar_of<decltype(lift(digit_fn{}))>.nullable == tri::maybe);
+static_assert(!nullable<decltype(lit('a').desc(errr{}).skip())>);
+
+static_assert(first_of(alt(lit('a'), lit('b'))).size() == 2);
+static_assert(first_of(then(pure, lit('x'))) == first_set::of('x'));
+static_assert(first_of(then(lit('x'), lit('y'))) == first_set::of('x'));
+static_assert(first_of(many(lit('a').then(cut(lit('b'))))).contains('a'));
+static_assert(first_of(llit).all);
+
+// A nullable parser also succeeds, without consuming, outside its first set.
+static_assert(first_of(many(lit('a'))) == first_set::of('a'));
+static_assert(first_of(alt(lit('a'), pure)) == first_set::of('a'));
+static_assert(many(lit('a'))("b"sv) && nullable<decltype(many(lit('a')))>);
+static_assert(alt(lit('a'), pure)("b"sv));
+
+template <typename P, typename Q>
+concept simplifies_to = std::same_as<P, strip<Q>>;
+
+using lit_t = decltype(lit('a'));
+
+static_assert(simplifies_to<decltype(alt(fail, lit('a'))), lit_t>);
+static_assert(simplifies_to<decltype(alt(fail.mute(), fail, lit('a'))), lit_t>);
+static_assert(simplifies_to<decltype(then(pure, lit('a'))), lit_t>);
+static_assert(simplifies_to<decltype(then(lit('a'), pure, pure)), lit_t>);
+static_assert(simplifies_to<decltype(alt(pure, lit('a'))), decltype(pure)>);
+static_assert(simplifies_to<decltype(alt(lit('a'), pure, lit('b'))),
+                            decltype(alt(lit('a'), pure))>);
+static_assert(simplifies_to<decltype(then(fail, lit('a'))), decltype(fail)>);
+static_assert(simplifies_to<decltype(then(fail.cut(), lit('a'))), decltype(fail.cut())>);
+static_assert(simplifies_to<decltype(lit('a').then(fail.cut()).then(lit('b'))),
+                            decltype(lit('a').then(fail.cut()))>);
+static_assert(simplifies_to<decltype(then(lit('a'), fail, lit('b'))),
+                            decltype(lit('a').then(fail))>);
+static_assert(simplifies_to<decltype(alt(then(lit('a'), fail), lit('b'))),
+                            decltype(lit('a').then(fail).alt(lit('b')))>);
+
+static_assert(simplifies_to<decltype(lit_t{}.skip().skip()), decltype(lit_t{}.skip())>);
+static_assert(simplifies_to<decltype(then(lit('a'), lit('b')).skip().skip()),
+                            decltype(then(lit('a'), lit('b')).skip())>);
+static_assert(simplifies_to<decltype(many(lit('a')).skip().skip()),
+                            decltype(many(lit('a')).skip())>);
+
+static_assert(alt(fail, lit('a'))("a"sv));
+static_assert(then(pure, lit('a'), pure)("ab"sv).unparsed == "b"sv);
+
+template <typename P>
+using fused = impl::parser_combinator::combinator<P>;
+
+static_assert(simplifies_to<decltype(then(lit('m'), lit('u'), lit('l')).skip()),
+                            fused<impl::lit_impl::chain<char, 3, false>>>);
+static_assert(simplifies_to<decltype(many(alt(lit('a'), lit('b')).skip())),
+                            fused<impl::lit_impl::span<char, true>>>);
+static_assert(first_of(alt(lit('a'), lit('b'), lit('c'))).size() == 3);
+
+static_assert(then(lit('m'), lit('u')).drop()("mux"sv).unparsed == "x"sv);
+static_assert(then(lit('m'), lit('u'), lit('l')).skip()("mux"sv).unparsed == "x"sv);
+static_assert(!then(lit('m'), lit('u'), lit('l')).skip()("mu"sv));
+static_assert(alt(lit('a'), lit('b'), lit('c'))("cx"sv).expected.value() == 'c');
+
+constexpr std::array<int, 1> wide = {'a' + 256};
+
+static_assert(!alt(lit('a'), lit('b'))(std::span<int const>{wide}));
+static_assert(many(alt(lit('a'), lit('b')))("abbac"sv).expected.value().size() == 4);
+
+constexpr auto in_range = [](char lo, char hi) static {
+  return satisfy([lo, hi](char c) -> std::expected<unit, errr> {
+    if (c >= lo && c <= hi) {
+      return {};
+    }
+    return std::unexpected(errr{});
+  });
+};
+
+constexpr auto agree = [](auto const &lhs, auto const &rhs, auto... inputs) static {
+  return ([&](SV in) {
+    auto [l_rest, l_res] = lhs(in);
+    auto [r_rest, r_res] = rhs(in);
+    return l_res.has_value() == r_res.has_value() && l_rest == r_rest;
+  }(inputs) && ...);
+};
+
+constexpr auto ident = pattern<"[a-z_][a-z0-9_]*">;
+constexpr auto ident_hand =
+    then(alt(in_range('a', 'z'), lit('_')),
+         many(alt(in_range('a', 'z'), in_range('0', '9'), lit('_'))));
+
+static_assert(ident("foo_1 bar"sv).expected.value() == "foo_1"sv);
+static_assert(agree(ident, ident_hand, "foo_1 bar"sv, "_"sv, "9x"sv, ""sv, "a9z!"sv));
+
+constexpr auto hex = pattern<"0[xX][0-9a-fA-F]+">;
+constexpr auto hex_digit =
+    alt(in_range('0', '9'), in_range('a', 'f'), in_range('A', 'F'));
+constexpr auto hex_hand =
+    then(lit('0'), alt(lit('x'), lit('X')), hex_digit, many(hex_digit));
+
+static_assert(hex("0xBEEFy"sv).expected.value() == "0xBEEF"sv);
+static_assert(agree(hex, hex_hand, "0x1f"sv, "0X"sv, "0xg"sv, "1x2"sv, "0xABCabc0"sv));
+
+constexpr auto date = pattern<"\\d\\d\\d\\d-\\d\\d-\\d\\d">;
+
+static_assert(date("2024-12-01T"sv).expected.value() == "2024-12-01"sv);
+static_assert(!date("2024-1-01"sv));
+static_assert(pattern<"colou?r|grey">("colour"sv).expected.value() == "colour"sv);
+static_assert(nullable<decltype(pattern<"a*">)>);
+static_assert(pattern<"a.c">("abc"sv) && !pattern<"a.c">("a\nc"sv));
+static_assert(pattern<"\\.[\\]\\d]+">(".]7x"sv).unparsed == "x"sv);
+static_assert(first_of(hex) == first_set::of('0'));
+
+constexpr auto ops = keywords<"mul", "do", "don't">;
+
+static_assert(ops("mul(2,3)"sv).expected.value() == 0);
+static_assert(ops("do()"sv).expected.value() == 1);
+static_assert(ops("don't()"sv).expected.value() == 2);
+static_assert(ops("don't()"sv).unparsed == "()"sv);
+static_assert(ops("don"sv).expected.value() == 1);
+static_assert(!ops("mux"sv));
+static_assert(!ops(""sv));
+static_assert(ops.skip()("dox"sv).unparsed == "x"sv);
+static_assert(first_of(ops) == (first_set::of('m') | first_set::of('d')));
+
+// Same length and prefix, told apart by a longer prefix.
+constexpr auto alike = keywords<"abcd1", "abcd2", "abce1", "abcd">;
+
+static_assert(alike("abcd2"sv).expected.value() == 1);
+static_assert(alike("abce1"sv).expected.value() == 2);
+static_assert(alike("abcd3"sv).expected.value() == 3);
+static_assert(!alike("abce"sv));
+
+constexpr auto instr = find_any<"mul(", "do()", "don't()">();
+
+static_assert(instr("#!mul(2,3)"sv).expected.value() == 0);
+static_assert(instr("#!mul(2,3)"sv).unparsed == "2,3)"sv);
+static_assert(instr("xdon't()do()"sv).expected.value() == 2);
+static_assert(!instr("mu(do("sv));
+static_assert(find_any<"he", "she", "hers">()("ushers"sv).expected.value() == 1);
+
+constexpr auto mul =
+    then(lit('m'), lit('u'), lit('l'), lit('('), in_range('0', '9'), lit(')'));
+
+static_assert(scan<"mul(">(mul.skip())("mul(x)mul(mul(7)z"sv).unparsed == "z"sv);
+static_assert(!scan<"mul(">(mul.skip())("mul(x)mul("sv));
+static_assert(scan<"do", "mul(">(alt(lit('d'), lit('m')))("#mul("sv).expected == 'm');
+static_assert(scan<"abcd", "c">(alt(lit('a'), lit('c')))("xabcd"sv).expected == 'a');
+static_assert(scan<"abcd", "c">(lit('c'))("xabcd"sv).unparsed == "d"sv);
+
 // =====
 // =====
 // =====
@@ -301,6 +595,53 @@ struct noop {
 
 static_assert(parser<noop<never>>);
 
+// Parsers need only be movable, `ref` shares one without copying.
+
+struct owned_table {
+
+  std::unique_ptr<bool[]> hit;
+
+  auto operator()(char c) const -> std::expected<unit, errr> {
+    if (hit[static_cast<unsigned char>(c)]) {
+      return {};
+    }
+    return std::unexpected(errr{});
+  }
+};
+
+using owning = decltype(satisfy(std::declval<owned_table>()));
+
+static_assert(parser<owning> && !std::copy_constructible<owning>);
+static_assert(parser<decltype(many(std::declval<owning>()).skip())>);
+static_assert(std::copy_constructible<decltype(ref(std::declval<owning const &>()))>);
+static_assert(!requires { ref(std::declval<owning>()); });
+
+// Erased parsers of the same declared types share a type.
+
+static_assert(std::same_as<decltype(opaque<SV, unit, unit>(lit('a').drop())),
+                           decltype(opaque<SV, unit, unit>(many(lit('b')).drop()))>);
+static_assert(std::same_as<decltype(opaque<SV>(then(lit('a'), lit('b')).drop())),
+                           opaque_t<SV, unit, unit>>);
+static_assert(parser<opaque_t<SV, unit, unit>, SV>);
+
+// Recognizers return compact results, infallible ones in two registers.
+
+static_assert(sizeof(result<SV, unit, errr>::expected_type) == sizeof(bool));
+static_assert(sizeof(result<SV, unit, yeti::never>) == sizeof(SV));
+static_assert(sizeof(result<SV, std::size_t, yeti::never>) ==
+              sizeof(SV) + sizeof(std::size_t));
+static_assert(std::is_trivially_copyable_v<result<SV, unit, yeti::never>>);
+
+using infallible_t = result<SV, int, yeti::never>::expected_type;
+
+static_assert(!std::constructible_from<infallible_t, std::unexpect_t>);
+static_assert(!std::constructible_from<infallible_t, std::unexpect_t, int>);
+static_assert(!std::constructible_from<infallible_t, std::unexpected<int>>);
+static_assert(std::constructible_from<infallible_t, std::unexpect_t, yeti::never>);
+static_assert(sizeof(many(lit('a')).drop()("aab"sv)) == sizeof(SV));
+static_assert(many(lit('a')).drop()("aab"sv).unparsed == "b"sv);
+static_assert(!then(lit('a'), lit('b')).drop()("ac"sv));
+
 } // namespace
 
 struct TypeTeller {
@@ -357,6 +698,15 @@ int main() {
 
   // constexpr auto cc = combinate(parser);
 
+  // Unknown escapes and a class cut short after an escape are rejected.
+  for (SV bad : {"\\b"sv, "\\x41"sv, "[\\d"sv, "[a\\"sv}) {
+    try {
+      std::ignore = impl::pattern_impl::compile(bad);
+      return 1;
+    } catch (std::invalid_argument const &) {
+    }
+  }
+
   {
     std::vector<int> data = {1, 1, 2, 3};
 
@@ -381,5 +731,337 @@ int main() {
     }
   }
 
+  {
+    auto got = speculate(llit, llit, "cccccccc"sv, {.threads = 4, .threshold = 0});
+
+    if (!got || got->size() != 8) {
+      return 1;
+    }
+  }
+
+  {
+    // Records contain their own sync token, chunk cuts land mid-record and
+    // guessed starts inside a record parse as (wrong) records.
+    auto rec = pattern<"k[a-z]*;">;
+
+    std::string in;
+
+    for (int i = 0; i < 60; ++i) {
+      in += i % 3 == 0 ? "kkak;" : i % 3 == 1 ? "kb;" : "kzzkzz;";
+    }
+
+    auto want = many(rec)(SV{in}).expected.value();
+
+    for (std::size_t threads : {2, 3, 4, 7, 16}) {
+
+      auto got = speculate(rec, lit('k'), SV{in}, {.threads = threads, .threshold = 0});
+
+      if (!got || got->size() != want.size()) {
+        return 1;
+      }
+
+      for (std::size_t i = 0; i < want.size(); ++i) {
+        if ((*got)[i].data() != want[i].data() || (*got)[i] != want[i]) {
+          return 1;
+        }
+      }
+    }
+
+    std::string bad = in;
+
+    std::size_t pos = bad.find("kb;", bad.size() / 2);
+
+    bad[pos + 1] = 'B';
+
+    // The error is located where the failed record stopped, past its 'k'.
+    auto split = lit('k').then(pattern<"[a-z]*;">);
+
+    auto err = speculate(split, lit('k'), SV{bad}, {.threads = 4, .threshold = 0});
+
+    if (err || err.error().offset != pos + 1) {
+      return 1;
+    }
+  }
+
+  {
+    std::size_t n = 0;
+
+    pusher push{llit, [&n](char) {
+                  ++n;
+                }};
+
+    std::FILE *pipe = ::popen("printf cccccccc", "r");
+
+    char buf[3];
+
+    for (std::size_t k; (k = std::fread(buf, 1, sizeof(buf), pipe)) > 0;) {
+      push.feed({buf, k});
+    }
+
+    ::pclose(pipe);
+
+    if (push.finish() != push_status::ready || n != 8) {
+      return 1;
+    }
+  }
+
+  {
+    // The alternative reports the rest of its rhs, yet the lhs ran out of input.
+    std::size_t n = 0;
+
+    pusher push{alt(lit('a').then(lit('b')).drop(), lit('x')), [&n](auto) {
+                  ++n;
+                }};
+
+    if (push.feed("a") != push_status::need_more) {
+      return 1;
+    }
+
+    if (push.feed("bx") != push_status::ready) {
+      return 1;
+    }
+
+    if (push.finish() != push_status::ready || n != 2) {
+      return 1;
+    }
+  }
+
+  {
+    pusher push{many(lit('a')), [](auto) {}};
+
+    if (push.feed("aab") != push_status::stalled) {
+      return 1;
+    }
+
+    if (push.finish() != push_status::stalled) {
+      return 1;
+    }
+  }
+
+  {
+    // The first feed leaves a record pending without compacting the buffer.
+    pusher push{pattern<"a*;">, [](auto) {}};
+
+    if (push.feed("a;aaaa") != push_status::need_more) {
+      return 1;
+    }
+
+    if (push.feed("x") != push_status::failed) {
+      return 1;
+    }
+
+    if (push.error()->offset + push.released() != 2) {
+      return 1;
+    }
+  }
+
+  {
+    packrat ctx;
+
+    auto parens = recursive<SV, unit>([&ctx](auto self) {
+      auto nested = memo(self, ctx);
+      return then(lit('('), nested, lit(')'), nested).drop().alt(pure);
+    });
+
+    if (parens("(()(()))()x"sv).unparsed != "x"sv || ctx.size() == 0) {
+      return 1;
+    }
+  }
+
+  {
+    auto nest = [](depth_options opt) {
+      return recursive<SV, unit>(
+          [](auto self) {
+            return then(lit('(').mute(), self, lit(')').mute()).skip().alt(pure);
+          },
+          opt);
+    };
+
+    std::string deep = std::string(200'000, '(') + std::string(200'000, ')');
+
+    // Without stack segments the native budget runs out first.
+    if (auto [rest, res] = nest({.max_depth = 1'000'000})(SV{deep}); !res || rest != "") {
+      if (YETI_STACK_SEGMENTS || res || res.error().what() != too_deep::what()) {
+        return 1;
+      }
+    }
+
+    if (auto [rest, res] = nest({.max_depth = 1'000})(SV{deep}); res) {
+      return 1;
+    } else if (res.error().what() != too_deep::what()) {
+      return 1;
+    }
+  }
+
+  {
+    std::istringstream in{"cccc"};
+
+    buffered buf{istream_source{in}, 2};
+
+    auto stream = buf.stream();
+
+    for (int i = 0; i < 4; ++i) {
+
+      auto [rest, res] = llit(stream);
+
+      if (!res) {
+        return 1;
+      }
+
+      buf.commit(rest);
+      stream = rest;
+    }
+
+    if (!eos(stream)) {
+      return 1;
+    }
+  }
+
+  {
+    std::vector<std::string> names = {"mul", "do", "don't", "don"};
+
+    trie dict{names};
+
+    auto ops = longest(dict);
+
+    if (ops("don't()"sv).expected != 2 || ops("dont"sv).expected != 3) {
+      return 1;
+    }
+
+    if (ops("do()"sv).unparsed != "()"sv || ops("mux"sv) || ops(""sv)) {
+      return 1;
+    }
+
+    if (many(then(ops, lit(';')).drop())("mul;don;do;"sv).unparsed != ""sv) {
+      return 1;
+    }
+  }
+
+  {
+    auto owned = longest(trie{std::vector<std::string>{"do", "don't"}});
+
+    if (owned("don't"sv).expected != 1) {
+      return 1;
+    }
+
+    if (many(std::move(owned))("dodo"sv).unparsed != ""sv) {
+      return 1;
+    }
+  }
+
+  {
+    // Keys of any owning type yielded by value are copied while building.
+    std::vector<SV> src{"a-key-too-long-for-the-small-string-buffer", "a-key"};
+
+    trie pmr{src | std::views::transform([](SV k) { return std::pmr::string(k); })};
+
+    if (longest(pmr)("a-key-too-long-for-the-small-string-buffer!"sv).expected != 0) {
+      return 1;
+    }
+  }
+
+  {
+    auto bits = opaque<SV>(many(alt(lit('0'), lit('1'))));
+
+    auto copy = bits;
+
+    if (copy("0110x"sv).expected.value().size() != 4 || copy("x"sv).unparsed != "x"sv) {
+      return 1;
+    }
+
+    auto owned = opaque<SV>(longest(trie{std::vector<std::string>{"do", "don't"}}));
+
+    auto shared = owned;
+
+    if (shared("don't"sv).expected != 1 || owned("dot"sv).unparsed != "t"sv) {
+      return 1;
+    }
+  }
+
+  {
+    auto hit = std::make_unique<bool[]>(256);
+
+    hit[std::size_t{'0'}] = hit[std::size_t{'1'}] = true;
+
+    auto bit = satisfy(owned_table{std::move(hit)});
+
+    auto pair = then(ref(bit), lit(','), ref(bit)).skip();
+
+    if (pair("1,0x"sv).unparsed != "x"sv || pair("1,2"sv)) {
+      return 1;
+    }
+
+    auto word = many(std::move(bit)).skip();
+
+    if (word("0110x"sv).unparsed != "x"sv) {
+      return 1;
+    }
+  }
+
+  {
+    std::vector<std::string> triggers = {"mul(", "do()", "don't()"};
+
+    aho_corasick dict{triggers};
+
+    if (find_any(dict)("..do()x"sv).expected != 1 || find_any(dict)("mu("sv)) {
+      return 1;
+    }
+
+    if (scan(mul.skip(), dict)("don't()mul(a)mul(3)!"sv).unparsed != "!"sv) {
+      return 1;
+    }
+
+    // Patterns yielded by value are kept alive while building.
+    aho_corasick owned{std::views::iota(0, 3) | std::views::transform([](int i) {
+                         return std::string(static_cast<std::size_t>(i) + 1,
+                                            static_cast<char>('b' + i));
+                       })};
+
+    if (find_any(owned)("xxdddcc"sv).expected != 2) {
+      return 1;
+    }
+
+    if (scan(lit('b'), owned)("xccbcc"sv).unparsed != "cc"sv) {
+      return 1;
+    }
+  }
+
+  // Repetitions allocate from the arena in scope, else from the heap.
+  {
+    auto fused = many(alt(lit('a'), lit('b')));
+    auto pairs = many(lit('a').then(lit('b')));
+
+    if (fused("ab"sv).expected.value().get_allocator().resource() != nullptr) {
+      return 1;
+    }
+
+    yeti::arena arena;
+
+    {
+      auto scope = arena.use();
+
+      auto runs = fused("abba"sv).expected.value();
+      auto reps = pairs("abab"sv).expected.value();
+
+      if (runs.size() != 4 || reps.size() != 2) {
+        return 1;
+      }
+
+      if (runs.get_allocator().resource() == nullptr) {
+        return 1;
+      }
+
+      if (reps.get_allocator() != runs.get_allocator()) {
+        return 1;
+      }
+    }
+
+    if (pairs("ab"sv).expected.value().get_allocator().resource() != nullptr) {
+      return 1;
+    }
+
+    arena.reset();
+  }
+
   return 0;
 }
@@ -0,0 +1,270 @@
+#include <memory>
+#include <memory_resource>
+#include <ranges>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "yoda.hpp"
+
+using namespace std::literals;
+using namespace yoda;
+
+namespace {
+
+constexpr auto csv_int = seq_left(number<int>, lit(','));
+
+static_assert(std::ranges::input_range<each_view<decltype(csv_int)>>);
+
+// Parsers need only be movable, `ref` shares one without copying.
+auto owned_bit() -> parser_of<char> auto {
+
+  auto hit = std::make_unique<bool[]>(256);
+
+  hit[std::size_t{'0'}] = hit[std::size_t{'1'}] = true;
+
+  return [hit = std::move(hit)](std::string_view sv) -> result<char> {
+    if (!sv.empty() && hit[static_cast<unsigned char>(sv[0])]) {
+      return {sv[0], sv.substr(1)};
+    }
+    return {std::unexpected("Expected a bit"s), sv};
+  };
+}
+
+using owning = decltype(owned_bit());
+
+static_assert(parser<owning> && !std::copy_constructible<owning>);
+static_assert(parser<decltype(star(seq(std::declval<owning>(), lit(','))))>);
+static_assert(std::copy_constructible<decltype(ref(std::declval<owning const &>()))>);
+static_assert(!requires { ref(std::declval<owning>()); });
+
+} // namespace
+
+int main() {
+
+  // Failures are located lazily from the unparsed rest.
+  {
+    auto ab = seq(lit('a'), eol, lit('b'));
+
+    if (!try_parse(ab, "a\nb"sv)) {
+      return 1;
+    }
+
+    auto r = try_parse(ab, "a\nxyz"sv);
+
+    if (r || r.error().offset != 2 || r.error().line() != 2 || r.error().column() != 1) {
+      return 1;
+    }
+
+    if (r.error().context(2) != "xy"sv || !r.error().what().contains("2:1")) {
+      return 1;
+    }
+
+    // At the end of the input the rest is a null view.
+    auto end = try_parse(seq(lit('a'), lit('b')), "a"sv);
+
+    if (end || end.error().offset != 1 || end.error().column() != 2) {
+      return 1;
+    }
+
+    bool threw = false;
+
+    try {
+      yoda::parse(ab, "a\nxyz"sv);
+    } catch (std::runtime_error const &) {
+      threw = true;
+    }
+
+    if (!threw) {
+      return 1;
+    }
+  }
+
+  // A move-only parser composes by value or, shared, through `ref`.
+  {
+    auto bit = owned_bit();
+
+    auto pair = seq(ref(bit), lit(','), ref(bit));
+
+    if (pair("1,0x"sv).rest != "x"sv || pair("1,2"sv)) {
+      return 1;
+    }
+
+    auto bits = star(alt(std::move(bit), lit('x')));
+
+    auto r = bits("01x1y"sv);
+
+    if (!r || r->size() != 4 || r.rest != "y"sv) {
+      return 1;
+    }
+  }
+
+  // Parallel records agree with a serial parse and report global offsets.
+  {
+    std::string in;
+    std::vector<int> want;
+
+    for (int i = 1; i <= 200; ++i) {
+      in += std::to_string(i) + '\n';
+      want.push_back(i);
+    }
+
+    par_options opt{.chunk = 16, .threshold = 0, .threads = 4};
+
+    auto got = try_parse(par_many(number<int>, '\n', opt), in);
+
+    if (!got || *got != want) {
+      return 1;
+    }
+
+    std::string bad = in;
+
+    std::size_t pos = bad.find("\n150\n") + 1;
+
+    bad[pos] = 'x';
+
+    auto err = try_parse(par_many(number<int>, '\n', opt), bad);
+
+    if (err || err.error().offset != pos) {
+      return 1;
+    }
+
+    // A record must be consumed up to its separator.
+    auto trailing = try_parse(par_many(number<int>, '\n', opt), "1\n2a\n3"sv);
+
+    if (trailing || trailing.error().offset != 3) {
+      return 1;
+    }
+  }
+
+  // The workers of par_many allocate from shards of the caller's arena.
+  {
+    std::string in;
+
+    for (int i = 0; i < 200; ++i) {
+      in += "aaa\n";
+    }
+
+    par_options opt{.chunk = 16, .threshold = 0, .threads = 4};
+
+    yoda::arena arena;
+
+    {
+      auto scope = arena.use();
+
+      auto got = try_parse(par_many(plus(lit('a')), '\n', opt), in);
+
+      if (!got || got->size() != 200) {
+        return 1;
+      }
+
+      auto *heap = std::pmr::new_delete_resource();
+
+      for (auto const &rec : *got) {
+        if (rec.size() != 3 || rec.get_allocator().resource() == heap) {
+          return 1;
+        }
+      }
+    }
+
+    arena.reset();
+  }
+
+  // Records are parsed lazily, the first error stops the iteration.
+  {
+    auto ok = parse_each(csv_int, "1,2,3,"sv);
+
+    int sum = 0;
+
+    for (int x : ok) {
+      sum += x;
+    }
+
+    if (sum != 6 || ok.error() || !ok.rest().empty()) {
+      return 1;
+    }
+
+    auto bad = parse_each(csv_int, "1,2,x,"sv);
+
+    std::vector<int> seen;
+
+    for (int x : bad) {
+      seen.push_back(x);
+    }
+
+    if (seen != std::vector{1, 2} || !bad.error() || bad.error()->offset != 4) {
+      return 1;
+    }
+
+    if (bad.rest() != "x,"sv) {
+      return 1;
+    }
+  }
+
+  // Repetitions allocate from the arena in scope, else from the heap.
+  {
+    auto heap = star(lit('a'))("aab"sv);
+
+    if (!heap || heap->size() != 2 || heap.rest != "b"sv) {
+      return 1;
+    }
+
+    if (heap->get_allocator().resource() != std::pmr::new_delete_resource()) {
+      return 1;
+    }
+
+    yoda::arena arena;
+
+    {
+      auto scope = arena.use();
+
+      auto r = plus(lit('a'))("aaa"sv);
+
+      if (!r || r->size() != 3 || r->get_allocator().resource() != resource()) {
+        return 1;
+      }
+
+      if (resource() == std::pmr::new_delete_resource()) {
+        return 1;
+      }
+    }
+
+    if (resource() != std::pmr::new_delete_resource()) {
+      return 1;
+    }
+
+    arena.reset();
+
+    if (plus(lit('a'))("b"sv) || rep(lit('a'), 2)("aaa"sv).rest != "a"sv) {
+      return 1;
+    }
+  }
+
+  // Rows are appended field by field into contiguous columns.
+  {
+    auto row = seq(seq_left(number<int>, lit(',')), seq_left(number<int>, lit('\n')));
+
+    auto r = columns(row)("1,2\n3,4\n5,6\nx"sv);
+
+    if (!r || r.rest != "x"sv) {
+      return 1;
+    }
+
+    auto const &[lhs, rhs] = *r;
+
+    if (lhs != std::vector{1, 3, 5} || rhs != std::vector{2, 4, 6}) {
+      return 1;
+    }
+
+    auto none = columns(row)(""sv);
+
+    if (!none || !std::get<0>(*none).empty()) {
+      return 1;
+    }
+  }
+
+  return 0;
+}